@@ -51,6 +51,30 @@ enum eBoardButtons
 	kBoardNumButtons
 };
 
+/** Buttons wired to an input; kBoardButtonNone is a placeholder. */
+#define BTN_WIRED_MASK		(~((uint64_t)1 << kBoardButtonNone))
+
+/** Analog input channels for this board. Each is set by a slider on the panel. */
+enum eBoardAnalogs
+{
+	kBoardAnalog0,
+	kBoardAnalog1,
+	kBoardAnalog2,
+	kBoardAnalog3,
+	kBoardNumAnalogs
+};
+
+/** Frames per second sampled on the analog inputs. */
+enum { kBoardAnalogRateHz = 1000 };
+
+/** This board has analog inputs; see cwsw_bsp_analog.h. */
+#define BOARD_ANALOG		1
+
+/** Channel 3 reads a resistor-ladder keypad of buttons 4 to 6 (its slider stands in for the ladder);
+ *	see cwsw_bsp_ladder.h.
+ */
+#define BOARD_LADDER		1
+
 enum eBoardLeds
 {
 	kBoardLed1,
@@ -76,6 +100,9 @@ enum eBoardLeds
 // ---- Discrete Functions -------------------------------------------------- {
 extern uint16_t	bd_gtk__Init(void);
 
+/** Inject a button sample into the simulated DI layer; lock-free, callable from any thread. */
+extern bool		di_button_inject(uint32_t idx, bool pressed, tCwswClockTics when);
+
 // ---- /Discrete Functions ------------------------------------------------- }
 
 // ---- Targets for Get/Set APIs -------------------------------------------- {
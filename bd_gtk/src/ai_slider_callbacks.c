@@ -0,0 +1,143 @@
+/** @file
+ *	@brief	Analog inputs of the GTK board: one slider ("rheostat") per channel.
+ *
+ *	The sliders set the level of their channel from the GTK main loop; the ADC read samples the
+ *	levels in force, at kBoardAnalogRateHz of the clock service's time, as a DMA-driven ADC scan would.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_board.h"	/* pull in the GTK info */
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum eAiSlider {
+	kAiFullScale	= 4095,							//!< 12-bit converter.
+	kAiBacklog		= kBoardAnalogRateHz / 10		//!< Most frames held for a late reader (100 ms); older ones are lost, as from a DMA ring.
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+/** Slider of each channel; run-time association w/ the "ain0".."ain3" IDs in the UI. A channel w/o
+ *	a slider reads 0.
+ */
+static GObject		*slider[kBoardNumAnalogs];
+
+/** Level of each channel, in counts. Written by the GTK callbacks, read by the ADC read. */
+static atomic_uint	level[kBoardNumAnalogs];
+
+static bool				started = false;
+static tCwswClockTics	tmstart;		//!< Clock time of frame 0.
+static uint32_t			framenext;		//!< Next frame to hand over.
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/** A slider has moved: scale its position onto the converter's range. */
+static void
+cbSliderChanged(GtkRange *range, gpointer data)
+{
+	uint32_t ch = (uint32_t)GPOINTER_TO_UINT(data);
+	GtkAdjustment *padj = gtk_range_get_adjustment(range);
+	gdouble lower = gtk_adjustment_get_lower(padj);
+	gdouble span = gtk_adjustment_get_upper(padj) - lower;
+	gdouble frac = (span > 0) ? (gtk_range_get_value(range) - lower) / span : 0;
+
+	if(ch >= kBoardNumAnalogs)	{ return; }
+	if(frac < 0)	{ frac = 0; }
+	if(frac > 1)	{ frac = 1; }
+	atomic_store_explicit(&level[ch], (unsigned)((frac * kAiFullScale) + 0.5), memory_order_relaxed);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+uint32_t
+ai_read_samples(uint16_t *pframes, uint32_t maxframes)
+{
+	tCwswClockTics now = Cwsw_ClockSvc__GetTime();
+	uint16_t frame[kBoardNumAnalogs];
+	uint32_t due, n, ch;
+
+	if(!pframes)	{ return 0; }
+	if(!started)
+	{
+		tmstart = now;
+		started = true;
+	}
+
+	// frames sampled by now, less those handed over.
+	due = (uint32_t)(((uint64_t)(uint32_t)(now - tmstart) * kBoardAnalogRateHz) / 1000U) - framenext;
+	if(due > kAiBacklog)
+	{
+		framenext += due - kAiBacklog;
+		due = kAiBacklog;
+	}
+	if(due > maxframes)	{ due = maxframes; }
+
+	// a slider moves at UI speed; every frame of one read takes the same levels.
+	for(ch = 0; ch < kBoardNumAnalogs; ++ch)
+	{
+		frame[ch] = (uint16_t)atomic_load_explicit(&level[ch], memory_order_relaxed);
+	}
+	for(n = 0; n < due; ++n)
+	{
+		for(ch = 0; ch < kBoardNumAnalogs; ++ch)
+		{
+			*pframes++ = frame[ch];
+		}
+	}
+	framenext += due;
+	return due;
+}
+
+void
+ai_slider_init(GtkBuilder *pUiPanel)
+{
+	static char const * const ids[kBoardNumAnalogs] = { "ain0", "ain1", "ain2", "ain3" };
+	uint32_t ch;
+
+	for(ch = 0; ch < kBoardNumAnalogs; ++ch)
+	{
+		atomic_init(&level[ch], 0);
+		slider[ch] = gtk_builder_get_object(pUiPanel, ids[ch]);
+		if(slider[ch])
+		{
+			g_signal_connect(slider[ch], "value-changed", G_CALLBACK(cbSliderChanged), GUINT_TO_POINTER(ch));
+			cbSliderChanged((GtkRange *)slider[ch], GUINT_TO_POINTER(ch));		// take up its initial position
+		}
+	}
+}
@@ -24,6 +24,8 @@
 
 // ----	Module Headers --------------------------
 #include "cwsw_board.h"
+#include "cwsw_bsp_buttons.h"	// Btn_MapCalibration()
+#include "cwsw_bsp_ladder.h"	// Ladder_SetTable()
 
 //#include "ManagedAlarms.h"	// temporary until i get architecture sorted out. the BSP should not know about
 //#include "tedlosevents.h"
@@ -70,6 +72,19 @@ static GtkBuilder *pUiPanel	= NULL;
 static GObject *pWindow		= NULL;
 static GError *error		= NULL;
 
+/** Ladder on channel 3: at rest it reads 0, and each button pulls it to its own quarter of the range.
+ *	The slider is noiseless; the hysteresis is sized for the noise of a real converter.
+ */
+static tLadderBand const ladderbands[] = {
+	{    0, kLadderNoButton },
+	{ 1024, kBoardButton4 },
+	{ 2048, kBoardButton5 },
+	{ 3072, kBoardButton6 }
+};
+static tLadder const ladders[] = {
+	{ kBoardAnalog3, ladderbands, sizeof(ladderbands) / sizeof(ladderbands[0]), 64 }
+};
+
 
 // ========================================================================== }
 // ----	Private Functions -----------------------------------------------------
@@ -127,6 +142,7 @@ Cwsw_Board__Init(ptEvQ_QueueCtrlEx pEvQX)
 	{
 		// ok, good, we have a window. now initialize the contents.
 		extern bool di_button_init(GtkBuilder *pUiPanel, ptEvQ_QueueCtrlEx pEvQX);
+		extern void ai_slider_init(GtkBuilder *pUiPanel);
 
 		// make the "x" in the window upper-right corner close the window
 		g_signal_connect(pWindow, "destroy", G_CALLBACK(gtk_main_quit), NULL);
@@ -141,6 +157,19 @@ Cwsw_Board__Init(ptEvQ_QueueCtrlEx pEvQX)
 			bad_init = di_button_init(pUiPanel, pEvQX);
 		}
 
+		if(!bad_init)		// analog inputs. the sliders are optional; a channel w/o one reads 0.
+		{
+			ai_slider_init(pUiPanel);
+			(void)Ladder_SetTable(ladders, sizeof(ladders) / sizeof(ladders[0]));
+			Ain_SetBlockTap(Ladder_Decode);
+		}
+
+		if(!bad_init)		// per-button calibration. w/o an image, the compiled-in defaults apply.
+		{
+			/* Note: hard-coded location, alongside the UI panel. */
+			(void)Btn_MapCalibration("../../cwsw_cfg/bsp/buttons.cal");
+		}
+
 		if(!bad_init)		// set up 1ms heartbeat
 		{
 			g_timeout_add(1, (GSourceFunc) tmHeartbeat, (gpointer)pWindow);		/* hard-coded 1 ms tic rate */
@@ -1,5 +1,9 @@
 /** @file
- *	@brief	One-sentence short description of file.
+ *	@brief	Simulated digital inputs of the GTK board: the button widgets' callbacks, and the
+ *	lock-free ring that carries their presses and releases, and any other thread's, to the DI scan.
+ *
+ *	Any thread may inject a sample w/ di_button_inject(); the scan drains the ring, in order, onto
+ *	the buttons' edge timelines (cwsw_bsp_di_sim.h) before it reads them.
  *
  *	\copyright
  *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
@@ -14,35 +18,39 @@
 
 // ----	System Headers --------------------------
 #include <stdbool.h>
+#include <stdatomic.h>
 
 // ----	Project Headers -------------------------
 
 // ----	Module Headers --------------------------
 #include "cwsw_board.h"	/* pull in the GTK info */
+#include "cwsw_bsp_di_sim.h"	/* edge timeline behind the simulated inputs */
+#include "cwsw_bsp_ladder.h"	/* buttons 4 to 6 are also on the ladder */
 
 
 // ============================================================================
 // ----	Constants -------------------------------------------------------------
 // ============================================================================
 
-//  consecutive 1s: 	    8          7        6       5      4     3   2  1 (meaningless noise to fill 64 bits)
-//	noisy input:		1111 1111 0111 1111 0111 1110 1111 1011 1101 1101 1010 0000 0011 1111 0000 0001
-#define noisypatterna	0xFF7F7EFBDDA03F01
-
-//	consecutive 0s:          8          7        6        5     4    3    2  1
-// noisy input:			1000 0000 0000 1000 0000 1000 0001 0000 0100 0010 0010 01010
-//						0x1 0010 1020 844A
-#define noisypatternb	0x100101020844A
-
-//						1111 1111 1001
-#define cleanpatterna	0xFF9
-#define cleanpatternb	~cleanpatterna
+/// Capacity of the input-injection ring; must be a power of 2.
+enum { kDiRingSize = 64 };
 
 
 // ============================================================================
 // ----	Type Definitions ------------------------------------------------------
 // ============================================================================
 
+/** One injected input sample.
+ *	`seq` implements the hand-off: the slot is free for the producer claiming position `pos` when
+ *	`seq == pos`, and holds a sample ready for the consumer when `seq == pos + 1`.
+ */
+typedef struct sDiSample {
+	atomic_uint		seq;
+	uint32_t		idx;		//!< Button ID.
+	bool			pressed;	//!< New level of the button.
+	tCwswClockTics	when;		//!< Clock time (ms) at which the button was operated.
+} tDiSample;
+
 // ============================================================================
 // ----	Global Variables ------------------------------------------------------
 // ============================================================================
@@ -51,8 +59,19 @@
 // ----	Module-level Variables ------------------------------------------------
 // ============================================================================
 
-static uint64_t buttoninputbits[kBoardNumButtons]	= {0};
-static uint32_t buttonstatus = 0;	// bitmapped image of current button state. 32 bits mostly to avoid compiler warnings.
+/* offset from GDK event time to the clock service's time base; latched at the 1st timestamped UI
+ * event. GTK callbacks only.
+ */
+static tCwswClockTics	gdkoffset;
+static bool				gdkoffsetvalid = false;
+
+/* bounded multi-producer / single-consumer ring of injected samples. producers (GTK callbacks, test
+ * threads, external feeders) claim a slot by advancing `ringhead`; the single consumer advances
+ * `ringtail`. neither side takes a lock.
+ */
+static tDiSample	ring[kDiRingSize];
+static atomic_uint	ringhead;
+static unsigned		ringtail;			// consumer only
 
 GObject *btn0		= NULL;
 GObject *btn1		= NULL;
@@ -74,6 +93,47 @@ tEvQ_QueueCtrlEx BtnQ = NULL;
 // ----	Private Functions -----------------------------------------------------
 // ============================================================================
 
+/** Clock time at which the UI event being handled occurred.
+ *	GDK stamps each input event with the window system's time (ms); mapping that onto the clock
+ *	service keeps the spacing of events that waited in the GTK main loop behind a busy scan.
+ */
+static tCwswClockTics
+UiEventTime(void)
+{
+	tCwswClockTics now = Cwsw_ClockSvc__GetTime();
+	guint32 evtime = gtk_get_current_event_time();
+	tCwswClockTics when;
+
+	if(evtime == GDK_CURRENT_TIME)	{ return now; }		// not called from an input event
+	if(!gdkoffsetvalid)
+	{
+		gdkoffset = now - (tCwswClockTics)evtime;
+		gdkoffsetvalid = true;
+	}
+	when = (tCwswClockTics)evtime + gdkoffset;
+	if((int32_t)(now - when) < 0)	{ when = now; }		// never in the future, whatever the clocks' drift
+	return when;
+}
+
+/** Move every sample injected since the last read onto the buttons' edge timelines. */
+static void
+DrainInjectedSamples(void)
+{
+	for(;;)
+	{
+		tDiSample *pslot = &ring[ringtail % kDiRingSize];
+		unsigned seq = atomic_load_explicit(&pslot->seq, memory_order_acquire);
+		if(seq != ringtail + 1)	{ break; }		// next slot not yet published: ring is empty
+
+		(void)di_sim_add_transition(pslot->idx, pslot->pressed, pslot->when);	// timeline full: drop
+
+		// hand the slot back to the producers, one lap ahead.
+		atomic_store_explicit(&pslot->seq, ringtail + kDiRingSize, memory_order_release);
+		++ringtail;
+	}
+}
+
+
 // ============================================================================
 // ----	Public Functions ------------------------------------------------------
 // ============================================================================
@@ -125,28 +185,8 @@ cbUiButtonPressed(GtkWidget *widget, gpointer data)
 		// empty final else clause
 	}
 
-	// toggle back and forth between two noisy sets of inputs.
-	// - the 1st is 64 bits of noise, the tail of which is 8 "on" bits (hence a debounced button press).
-	// - the 2nd intentionally fails qualification for a button press; remember that this function
-	//	"sets" the pressed indicator, we we have to book-end the embedded 0 bits with "1" markers to
-	// make the detection algorithms work.
-
 	// call into the next layer down (arch)
-	// for exploration, we'll use 8 consecutive bits of the same value to detect a state change
-#if 0
-	static bool noisypattern = false;	// location here in this function requires C99, prohibits Visual Studio
-	buttoninputbits[idx] = noisypattern ? noisypatterna : noisypatternb; noisypattern = !noisypattern;
-#else
-	if(buttoninputbits[idx])
-	{
-		buttoninputbits[idx] += cleanpatterna * 4096; // clean pattern is 12 bits
-	}
-	else
-	{
-		buttoninputbits[idx] = cleanpatterna;
-	}
-#endif
-	BIT_SET(buttonstatus, idx);
+	(void)di_button_inject(idx, true, UiEventTime());
 }
 
 void
@@ -168,48 +208,83 @@ cbUiButtonReleased(GtkWidget *widget, gpointer data)
 	}
 
 	// call into the next layer down (arch)
-#if 0
-	static bool noisypattern = false;	// location here in this function requires C99, prohibits Visual Studio
-	buttoninputbits[idx] = noisypattern ? noisypatternb : noisypatterna; noisypattern = !noisypattern;
-#else
-	if(buttoninputbits[idx])
-	{
-		buttoninputbits[idx] += (uint64_t)((cleanpatternb & 0xFFF) * 4096);
-	}
-	else
-	{
-		buttoninputbits[idx] = (uint64_t)((cleanpatternb & 0xFFF));
-	}
-#endif
-	BIT_CLR(buttonstatus, idx);
+	(void)di_button_inject(idx, false, UiEventTime());
 
 	/* running commentaire, to be moved to more formal documentation.
-	 * - if the DI button SM is in the "released" state, the 1st 1 bit will provoke a transition to
-	 *   the debounce-press state; after the bit stream settles down to all 0s, it'll return to the
-	 *   released state.
+	 * - if the DI button SM is in the "pressed" state, the 1st "released" edge will provoke a
+	 *   transition to the debounce-release state; the bounce that follows restarts the debounce,
+	 *   and once the timeline settles at "released", the SM reaches the released state.
 	 */
 	return;
 }
 
 
+/** Inject one button sample into the simulated DI layer.
+ *	Safe to call from any thread, concurrently with other producers and with the DI read; it never
+ *	blocks.
+ *	@param[in]	idx		Button ID.
+ *	@param[in]	pressed	New level of the button.
+ *	@param[in]	when	Clock time (ms) at which the button was operated.
+ *	@returns false if the sample was dropped because the button ID is invalid or the ring is full.
+ */
 bool
-di_read_next_button_input_bit(uint32_t idx)
+di_button_inject(uint32_t idx, bool pressed, tCwswClockTics when)
 {
-	bool retval = ((buttoninputbits[idx] & 1) != 0);
-	buttoninputbits[idx] /= 2;
-	if((!retval) && (!buttoninputbits[idx]))	// if this bit is clear, it could be because the input stream is depleted; if the input stream is also depleted...
-	{	// ... then check whether the "button pressed" flag is true
-		// toggle buttons didn't work as i wanted - each press also gets a release, but it's a press-release sandwich where the "pressed" status is the meat
-//		retval = gtk_toggle_button_get_active((GtkToggleButton *)btn0);	// todo: return state of last button pressed
-		retval = BIT_TEST(buttonstatus, idx);
+	tDiSample *pslot;
+	unsigned pos;
+
+	if(idx >= kBoardNumButtons)	{ return false; }
+
+	pos = atomic_load_explicit(&ringhead, memory_order_relaxed);
+	for(;;)
+	{
+		unsigned seq;
+		pslot = &ring[pos % kDiRingSize];
+		seq = atomic_load_explicit(&pslot->seq, memory_order_acquire);
+		if(seq == pos)
+		{
+			// slot is free: try to claim it. on failure, `pos` is reloaded w/ the current head.
+			if(atomic_compare_exchange_weak_explicit(&ringhead, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if((int)(seq - pos) < 0)
+		{
+			return false;		// slot still holds a sample from the previous lap: ring is full
+		}
+		else
+		{
+			pos = atomic_load_explicit(&ringhead, memory_order_relaxed);	// another producer got here 1st
+		}
 	}
-	return retval;
+
+	pslot->idx = idx;
+	pslot->pressed = pressed;
+	pslot->when = when;
+	atomic_store_explicit(&pslot->seq, pos + 1, memory_order_release);	// publish
+	return true;
+}
+
+bool
+di_read_next_button_input_bit(uint32_t idx)
+{
+	DrainInjectedSamples();
+	// a ladder button is wired in parallel w/ its panel button: either one presses it.
+	return di_sim_level_at(idx, Cwsw_ClockSvc__GetTime()) || Ladder_ButtonInput(idx);
 }
 
 bool
 di_button_init(GtkBuilder *pUiPanel, ptEvQ_QueueCtrlEx pEvQX)
 {
 	bool bad_init = false;
+	unsigned slot;
+
+	// each ring slot starts out free for the 1st lap of producers.
+	for(slot = 0; slot < kDiRingSize; ++slot)
+	{
+		atomic_init(&ring[slot].seq, slot);
+	}
 
 	/* we want button-press and button-release events. for convenience and exploration, we'll also
 	 * capture the click event.
@@ -50,6 +50,9 @@ enum eBoardButtons
 	kBoardNumButtons /**< kBoardNumButtons */
 };
 
+/** Buttons wired to an input; kBoardButtonNone is a placeholder. */
+#define BTN_WIRED_MASK		(~((uint64_t)1 << kBoardButtonNone))
+
 enum eBoardLeds
 {
 	kBoardLed1,
@@ -0,0 +1,30 @@
+#!/bin/sh
+# Count the button engine's cache misses per scan on a simulated L1D (src/cache_sim.c), for hosts w/o
+# hardware counters: build the engine w/ -fsanitize=thread, so that each load and store is passed to
+# the model, and run the benchmark for each engine, button count and mix.
+# Usage: bench/cache.sh [extra compiler flags...]
+# CC, the engines (ENGINES), the button counts (BUTTONS) and the scans per mix (SCANS) may be
+# overridden from the environment.
+
+cd "$(dirname "$0")/.." || exit 1
+CC=${CC:-gcc}
+ENGINES=${ENGINES:-"0 1"}
+BUTTONS=${BUTTONS:-"8 256 4096"}
+SCANS=${SCANS:-10240}
+OUT=${TMPDIR:-/tmp}/btn_cache.$$
+
+header=-H
+for engine in $ENGINES; do
+	for n in $BUTTONS; do
+		$CC -O2 -std=gnu11 -Wall -Wextra -Wno-tsan -fsanitize=thread -DBTN_ENGINE=$engine -DBENCH_NUM_BUTTONS=$n "$@" \
+			-Ibench -Ibench/stubs -Icommon -c common/src/cwsw_bsp_buttons.c -o "$OUT.o" || exit 1
+		$CC -O2 -std=gnu11 -Wall -Wextra -DBTN_ENGINE=$engine -DBENCH_NUM_BUTTONS=$n -DBENCH_CACHE_SIM=1 "$@" \
+			-Ibench -Ibench/stubs -Icommon \
+			bench/src/btn_bench.c bench/src/cache_sim.c "$OUT.o" -o "$OUT" || exit 1
+		for mix in idle bursty busy stuck; do
+			"$OUT" $header $mix $SCANS || exit 1
+			header=
+		done
+	done
+done
+rm -f "$OUT" "$OUT.o"
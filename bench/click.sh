@@ -0,0 +1,20 @@
+#!/bin/sh
+# Check that the simulated DI's timeline debounces into the events the desktop UIs mean, for each
+# engine: build src/di_sim_click.c w/ the engine and the timeline, and run its cases.
+# Usage: bench/click.sh [extra compiler flags...]
+# CC may be overridden from the environment.
+
+cd "$(dirname "$0")/.." || exit 1
+CC=${CC:-gcc}
+OUT=${TMPDIR:-/tmp}/di_sim_click.$$
+
+status=0
+for engine in 0 1; do
+	echo "engine $engine:"
+	$CC -O2 -std=gnu11 -Wall -Wextra -DBTN_ENGINE=$engine "$@" \
+		-Ibench -Ibench/stubs -Icommon \
+		bench/src/di_sim_click.c common/src/cwsw_bsp_di_sim.c common/src/cwsw_bsp_buttons.c -o "$OUT" || exit 1
+	"$OUT" || status=1
+done
+rm -f "$OUT"
+exit $status
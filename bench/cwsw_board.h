@@ -0,0 +1,57 @@
+/** @file
+ *	@brief	Board Support Package Header File for the button-engine benchmark.
+ *
+ *	A board with nothing but buttons, as many as the benchmark is built for. Its inputs come from the
+ *	benchmark's input source (Btn_SetInputSource()), not from a DI layer.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+#ifndef CWSW_BOARD_H
+#define CWSW_BOARD_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "../cwsw_board_common.h"
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/** Number of buttons on the benchmark board. Override via command line. */
+#if !defined(BENCH_NUM_BUTTONS)
+#define BENCH_NUM_BUTTONS	64
+#endif
+
+/** Button IDs for this board. */
+enum eBoardButtons
+{
+	kBoardButtonNone,
+	kBoardNumButtons = BENCH_NUM_BUTTONS
+};
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_BOARD_H */
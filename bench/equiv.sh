@@ -0,0 +1,39 @@
+#!/bin/sh
+# Check that both button engines post the same events for the same input: build the event logger
+# for each engine, run both on the same seeded, bouncy input, and compare the logs.
+# Usage: bench/equiv.sh [extra compiler flags...]    e.g. bench/equiv.sh -DBTN_GESTURES=1
+# CC, the button count (BUTTONS), the scans (SCANS) and the seed (SEED) may be overridden from the
+# environment.
+#
+# After a change to either engine, check at least:
+#	bench/equiv.sh
+#	bench/equiv.sh -march=native                                   (the vertical counters' AVX2 lanes)
+#	bench/equiv.sh -DBTN_BATCH_EVENTS=1                            (their direct-to-batch path)
+#	bench/equiv.sh -DBTN_BATCH_EVENTS=1 -DBTN_GESTURES=1           (batch w/ gestures, which must see each edge)
+#	BUTTONS=300 bench/equiv.sh                                     (more than one lane step)
+
+cd "$(dirname "$0")/.." || exit 1
+CC=${CC:-gcc}
+BUTTONS=${BUTTONS:-70}
+SCANS=${SCANS:-200000}
+SEED=${SEED:-1}
+OUT=${TMPDIR:-/tmp}/btn_equiv.$$
+
+status=0
+for cal in "" -c; do
+	for engine in 0 1; do
+		$CC -O2 -std=gnu11 -Wall -Wextra -DBTN_ENGINE=$engine -DBENCH_NUM_BUTTONS=$BUTTONS "$@" \
+			-Ibench -Ibench/stubs -Icommon \
+			bench/src/btn_equiv.c common/src/cwsw_bsp_buttons.c -o "$OUT.bin" || exit 1
+		"$OUT.bin" $cal $SCANS $SEED > "$OUT.$engine" || exit 1
+	done
+	if cmp -s "$OUT.0" "$OUT.1"; then
+		echo "same events${cal:+ (varied calibration)}: $(wc -l < "$OUT.0") events"
+	else
+		echo "DIFFERENT events${cal:+ (varied calibration)}:"
+		diff "$OUT.0" "$OUT.1" | head -10
+		status=1
+	fi
+done
+rm -f "$OUT.bin" "$OUT.0" "$OUT.1"
+exit $status
@@ -0,0 +1,356 @@
+/** @file
+ *	@brief	Microbenchmark of the button engine (Btn_tsk_ButtonRead()).
+ *
+ *	Drives the engine headless, from precomputed input patterns, and reports for each input mix:
+ *	- time per button per scan,
+ *	- button events posted per second (everything NotifyBtnStateChg() and the batch logic post),
+ *	- instructions and cache misses per scan (Linux, where perf events are available to the user), or
+ *	  w/ #BENCH_CACHE_SIM, the misses of a simulated L1D.
+ *
+ *	The button count and the engine are fixed at build time; bench/sweep.sh rebuilds across them.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ----	Project Headers -------------------------
+#include "cwsw_board.h"
+#include "cwsw_bsp_buttons.h"
+#include "cwsw_bsp_buttons_cfg.h"
+
+// ----	Module Headers --------------------------
+#if !defined(BENCH_CACHE_SIM)
+/** Count the misses of the engine's loads and stores on a simulated cache (cache_sim.c), in place of
+ *	the hardware counters. The engine must be built w/ `-fsanitize=thread`; bench/cache.sh does so.
+ *	Timings are then of the instrumented engine, and are not reported.
+ */
+#define BENCH_CACHE_SIM	0
+#endif
+#if (BENCH_CACHE_SIM)
+#include "cache_sim.h"
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum eBenchSizes {
+	/// Scans run before timing starts; long enough for held buttons to be reported stuck, so every
+	///	mix is measured in its steady state.
+	kBenchWarmupScans = 4000,
+
+	/// Button-scans to time, by default; the scan count is this divided by the button count.
+	kBenchButtonScans = 100000000,
+
+	/// Fewest scans to time.
+	kBenchMinScans = 1000,
+
+	/// Scans in one cycle of the "bursty" pattern.
+	kBenchBurstPeriod = 512
+};
+
+/** Input mixes. */
+enum eBenchMix { kMixIdle, kMixBursty, kMixBusy, kMixStuck, kNumMixes };
+
+static char const * const mixname[kNumMixes] = { "idle", "bursty", "busy", "stuck" };
+
+/** Hardware counters read around the timed scans. */
+enum eBenchCounters { kCtrInstructions, kCtrCacheMisses, kNumCounters };
+
+#if (BTN_ENGINE == BTN_ENGINE_VERTICAL_COUNTER)
+#define BENCH_ENGINE_NAME	"vc"
+#else
+#define BENCH_ENGINE_NAME	"sme"
+#endif
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tEvQ_QueueCtrlEx evqbtn;
+
+/** Input pattern of the mix being run: `period` scans of port words. */
+static tBtnPortWord	*pattern = NULL;
+static uint32_t		period = 1;
+static uint32_t		scan = 0;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/** Scrambled button ID, to spread the bursty mix's presses across buttons and time. */
+static uint32_t
+Hash(uint32_t x)
+{
+	x ^= x >> 16;	x *= 0x7FEB352DU;
+	x ^= x >> 15;	x *= 0x846CA68BU;
+	x ^= x >> 16;
+	return x;
+}
+
+static void
+SetInput(uint32_t tick, uint32_t idx)
+{
+	pattern[(tick * kBtnNumPortWords) + (idx / kBtnBitsPerWord)] |= (tBtnPortWord)1 << (idx % kBtnBitsPerWord);
+}
+
+/** Build the input pattern of one mix.
+ *	- idle:		every button released.
+ *	- bursty:	one button in ten is pressed once per cycle, for 40 to 79 scans, with a one-scan
+ *				bounce after the press and after the release; the rest are released.
+ *	- busy:		every button is pressed once per cycle, as the bursty mix's are.
+ *	- stuck:	every fourth button held; the rest released.
+ */
+static void
+BuildPattern(enum eBenchMix mix)
+{
+	uint32_t idx, tick;
+
+	period = ((mix == kMixBursty) || (mix == kMixBusy)) ? kBenchBurstPeriod : 1;
+	free(pattern);
+	pattern = (tBtnPortWord *)calloc((size_t)period * kBtnNumPortWords, sizeof(tBtnPortWord));
+	if(!pattern)	{ exit(EXIT_FAILURE); }
+
+	for(idx = 0; idx < kBoardNumButtons; ++idx)
+	{
+		uint32_t h = Hash(idx);
+		switch(mix)
+		{
+		case kMixBursty:
+		case kMixBusy:
+			if((mix == kMixBusy) || ((h % 10) == 0))
+			{
+				uint32_t t0 = (h >> 8) % (kBenchBurstPeriod - 128);
+				uint32_t hold = 40 + ((h >> 20) % 40);
+				for(tick = t0; tick < t0 + hold; ++tick)
+				{
+					if(tick != t0 + 1)	{ SetInput(tick, idx); }
+				}
+				SetInput(t0 + hold + 1, idx);
+			}
+			break;
+
+		case kMixStuck:
+			if((idx % 4) == 0)	{ SetInput(0, idx); }
+			break;
+
+		case kMixIdle:
+		default:
+			break;
+		}
+	}
+}
+
+/** Input source: this scan's slice of the pattern. */
+static void
+PatternSource(tBtnPortWord inputs[kBtnNumPortWords])
+{
+	(void)memcpy(inputs, &pattern[(scan % period) * kBtnNumPortWords], sizeof(tBtnPortWord) * kBtnNumPortWords);
+	++scan;
+}
+
+static double
+Now(void)
+{
+	struct timespec ts;
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+/** Open a counter of one user-mode hardware event of this thread; -1 if not available.
+ *	@param[in]	ctr		Counter (#eBenchCounters).
+ */
+static int
+OpenCounter(enum eBenchCounters ctr)
+{
+#if defined(__linux__)
+	struct perf_event_attr attr;
+	(void)memset(&attr, 0, sizeof(attr));
+	attr.type			= PERF_TYPE_HARDWARE;
+	attr.size			= sizeof(attr);
+	attr.config			= (ctr == kCtrCacheMisses) ? PERF_COUNT_HW_CACHE_MISSES : PERF_COUNT_HW_INSTRUCTIONS;
+	attr.disabled		= 1;
+	attr.exclude_kernel	= 1;
+	attr.exclude_hv		= 1;
+	return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+	UNUSED(ctr);
+	return -1;
+#endif
+}
+
+/** Zero and start a counter, if it's open. */
+static void
+StartCounter(int fd)
+{
+#if defined(__linux__)
+	if(fd >= 0)	{ (void)ioctl(fd, PERF_EVENT_IOC_RESET, 0); (void)ioctl(fd, PERF_EVENT_IOC_ENABLE, 0); }
+#else
+	UNUSED(fd);
+#endif
+}
+
+/** Stop a counter, and format its count per scan into `text`; "n/a" if it isn't open. */
+static void
+StopCounter(int fd, uint32_t scans, char *text, size_t size)
+{
+	long long count = -1;
+#if defined(__linux__)
+	if(fd >= 0)
+	{
+		(void)ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+		if(read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count))	{ count = -1; }
+	}
+#else
+	UNUSED(fd);
+#endif
+	if(count >= 0)	{ (void)snprintf(text, size, "%.*f", (count < (long long)scans * 10) ? 2 : 0, (double)count / scans); }
+	else			{ (void)snprintf(text, size, "n/a"); }
+}
+
+static void
+RunMix(enum eBenchMix mix, uint32_t scans, int const fd[kNumCounters])
+{
+	tEvQ_Event ev = { evButton_Task, 0 };
+	uint32_t events;
+	double t0, elapsed;
+	char text[kNumCounters][32], pace[32], rate[32];
+#if (BENCH_CACHE_SIM)
+	uint64_t misses;
+#endif
+	uint32_t n;
+	int ctr;
+
+	BuildPattern(mix);
+	for(n = 0; n < kBenchWarmupScans; ++n)	{ Btn_tsk_ButtonRead(ev, 0); }
+
+	events = evqbtn.numposted;
+	for(ctr = 0; ctr < kNumCounters; ++ctr)	{ StartCounter(fd[ctr]); }
+#if (BENCH_CACHE_SIM)
+	misses = CacheSim_Misses();
+#endif
+	t0 = Now();
+	for(n = 0; n < scans; ++n)	{ Btn_tsk_ButtonRead(ev, 0); }
+	elapsed = Now() - t0;
+	for(ctr = 0; ctr < kNumCounters; ++ctr)	{ StopCounter(fd[ctr], scans, text[ctr], sizeof(text[ctr])); }
+	events = evqbtn.numposted - events;
+
+#if (BENCH_CACHE_SIM)
+	UNUSED(elapsed);
+	(void)snprintf(text[kCtrCacheMisses], sizeof(text[kCtrCacheMisses]), "%.2f", (double)(CacheSim_Misses() - misses) / scans);
+	(void)snprintf(pace, sizeof(pace), "n/a");
+	(void)snprintf(rate, sizeof(rate), "%.2f", (double)events / scans);
+#else
+	(void)snprintf(pace, sizeof(pace), "%.3f", (elapsed * 1e9) / ((double)scans * kBoardNumButtons));
+	(void)snprintf(rate, sizeof(rate), "%.0f", events / elapsed);
+#endif
+	printf("%-6s %8u  %-7s %10u %12s %14s %14s %14s\n",
+		BENCH_ENGINE_NAME, (unsigned)kBoardNumButtons, mixname[mix], (unsigned)scans,
+		pace, rate, text[kCtrInstructions], text[kCtrCacheMisses]);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/** Stand-in for the event queue: count the event. */
+int16_t
+Cwsw_EvQX__PostEvent(ptEvQ_QueueCtrlEx pEvQX, tEvQ_Event ev)
+{
+	UNUSED(ev);
+	++pEvQX->numposted;
+	return kErr_Lib_NoError;
+}
+
+/** Not used; the benchmark's inputs come from PatternSource(). */
+bool
+di_read_next_button_input_bit(uint32_t idx)
+{
+	UNUSED(idx);
+	return false;
+}
+
+/** Usage: btn_bench [-H] [mix [scans]]
+ *	-H		also print the column header.
+ *	mix		idle, bursty, busy or stuck; all four if omitted.
+ *	scans	scans to time; by default, enough for 1e8 button-scans.
+ */
+int
+main(int argc, char *argv[])
+{
+	uint32_t scans = kBenchButtonScans / kBoardNumButtons;
+	int first = 0, last = kNumMixes - 1;
+	int argn = 1;
+	int fd[kNumCounters];
+	int mix, ctr;
+
+	if((argn < argc) && !strcmp(argv[argn], "-H"))
+	{
+		printf("%-6s %8s  %-7s %10s %12s %14s %14s %14s\n", "engine", "buttons", "mix", "scans", "ns/btn/scan",
+			BENCH_CACHE_SIM ? "events/scan" : "events/s", "instr/scan", BENCH_CACHE_SIM ? "L1D miss/scan" : "misses/scan");
+		++argn;
+	}
+	if(argn < argc)
+	{
+		for(mix = 0; (mix < kNumMixes) && strcmp(argv[argn], mixname[mix]); ++mix)	{}
+		if(mix == kNumMixes)
+		{
+			fprintf(stderr, "unknown mix: %s\n", argv[argn]);
+			return EXIT_FAILURE;
+		}
+		first = last = mix;
+		++argn;
+	}
+	if(argn < argc)		{ scans = (uint32_t)strtoul(argv[argn], NULL, 0); }
+	if(scans < kBenchMinScans)	{ scans = kBenchMinScans; }
+
+	Btn_SetQueue(evButton_Task, &evqbtn);
+	Btn_SetInputSource(PatternSource);
+	// the instrumented engine's instruction count would be mostly its instrumentation.
+	for(ctr = 0; ctr < kNumCounters; ++ctr)	{ fd[ctr] = BENCH_CACHE_SIM ? -1 : OpenCounter((enum eBenchCounters)ctr); }
+
+	for(mix = first; mix <= last; ++mix)
+	{
+		RunMix((enum eBenchMix)mix, scans, fd);
+	}
+
+#if defined(__linux__)
+	for(ctr = 0; ctr < kNumCounters; ++ctr)
+	{
+		if(fd[ctr] >= 0)	{ (void)close(fd[ctr]); }
+	}
+#endif
+	free(pattern);
+	return EXIT_SUCCESS;
+}
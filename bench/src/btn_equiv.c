@@ -0,0 +1,246 @@
+/** @file
+ *	@brief	Event log of the button engine, for checking that both engines post the same events.
+ *
+ *	Drives the engine headless from a seeded, bouncy random input, and prints every event it posts,
+ *	one per line, with the scan that posted it. Built once per engine from the same seed, the two
+ *	logs must be identical; bench/equiv.sh builds, runs and compares them. W/ #BTN_BATCH_EVENTS, each
+ *	batch is logged w/ its contents; w/ #BTN_GESTURES, every button gets gestures, of four kinds in
+ *	turn, so that their events are compared too.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_board.h"
+#include "cwsw_bsp_buttons.h"
+#include "cwsw_bsp_buttons_cfg.h"
+
+// ----	Module Headers --------------------------
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum eEquivSizes {
+	kEquivDefaultScans	= 200000,		//!< Scans run, by default.
+	kEquivMaxWindow		= 32,			//!< Longest debounce window of the varied calibration, in scans.
+	kEquivRecalScans	= 5000			//!< Scans between redraws of the varied calibration.
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/** Input generator of one button: the level it is heading for, and how long it holds it. */
+typedef struct sEquivInput {
+	uint32_t	left;			//!< Scans until the next change of level.
+	uint8_t		level;			//!< Settled level; 1 == pressed.
+	uint32_t	bounce;			//!< Scans of contact bounce left after the latest change.
+} tEquivInput;
+
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tEvQ_QueueCtrlEx evqbtn;
+
+static tEquivInput		gen[kBoardNumButtons];
+static uint32_t			seed = 1;
+static uint32_t			scan = 0;
+static tBtnCalibration	cal[kBoardNumButtons];
+#if (BTN_GESTURES)
+static tBtnGesture		gestures[kBoardNumButtons];
+#endif
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+static uint32_t
+Rand(uint32_t range)
+{
+	seed = (seed * 1103515245U) + 12345U;
+	return ((seed >> 8) & 0xFFFFFFU) % range;
+}
+
+/** How long the next level lasts: mostly short and near the debounce windows, sometimes long
+ *	enough for a press to be reported stuck.
+ */
+static uint32_t
+HoldFor(void)
+{
+	uint32_t r = Rand(100);
+	if(r < 50)	{ return 1 + Rand(14); }
+	if(r < 95)	{ return 10 + Rand(200); }
+	return 2900 + Rand(400);
+}
+
+/** Input source: the next sample of every button. */
+static void
+RandomSource(tBtnPortWord inputs[kBtnNumPortWords])
+{
+	uint32_t idx;
+
+	(void)memset(inputs, 0, sizeof(tBtnPortWord) * kBtnNumPortWords);
+	for(idx = 0; idx < kBoardNumButtons; ++idx)
+	{
+		tEquivInput *pg = &gen[idx];
+		uint8_t level;
+
+		if(!pg->left--)
+		{
+			pg->level ^= 1;
+			pg->left = HoldFor();
+			// now and then, chatter for longer than the debounce timeout.
+			pg->bounce = (Rand(100) < 3) ? 60 + Rand(100) : Rand(6);
+		}
+		if(pg->bounce)
+		{
+			--pg->bounce;
+			level = (uint8_t)Rand(2);
+		}
+		else
+		{
+			level = pg->level;
+		}
+		if(level)	{ inputs[idx / kBtnBitsPerWord] |= (tBtnPortWord)1 << (idx % kBtnBitsPerWord); }
+	}
+	++scan;
+}
+
+/** A calibration w/ every button's windows and stuck timeout drawn at random, and one button in
+ *	eight disabled.
+ */
+static void
+VaryCalibration(void)
+{
+	uint32_t idx;
+	for(idx = 0; idx < kBoardNumButtons; ++idx)
+	{
+		cal[idx].tmPressDebounce	= (uint16_t)(tmr10ms * (1 + Rand(kEquivMaxWindow)));
+		cal[idx].tmReleaseDebounce	= (uint16_t)(tmr10ms * (1 + Rand(kEquivMaxWindow)));
+		cal[idx].tmStuck			= (uint16_t)(tmr10ms * (20 + Rand(400)));
+		cal[idx].enabled			= (Rand(8) != 0);
+		cal[idx].strategy			= kBtnDebounceShiftRegister;
+	}
+	Btn_SetCalibration(cal);
+}
+
+#if (BTN_GESTURES)
+/** Gestures for every button: long-press, double-click, repeat, or toggle, in turn. The times are
+ *	in range of the input's holds and gaps, so each gesture happens often.
+ */
+static void
+SetGestures(void)
+{
+	uint32_t idx;
+	for(idx = 0; idx < kBoardNumButtons; ++idx)
+	{
+		tBtnGesture *pg = &gestures[idx];
+		switch(idx % 4)
+		{
+		case 0:		pg->tmLongPress = 800;							break;
+		case 1:		pg->tmDoubleClick = 500;						break;
+		case 2:		pg->tmRepeatDelay = 600; pg->tmRepeatRate = 200;	break;
+		default:	pg->toggle = 1;									break;
+		}
+	}
+	Btn_SetGestures(gestures);
+}
+#endif
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/** Stand-in for the event queue: log the event. */
+int16_t
+Cwsw_EvQX__PostEvent(ptEvQ_QueueCtrlEx pEvQX, tEvQ_Event ev)
+{
+	++pEvQX->numposted;
+	printf("%u %d %u", (unsigned)scan, (int)ev.evId, (unsigned)ev.evData);
+#if (BTN_BATCH_EVENTS)
+	if(ev.evId == evButton_Batch)
+	{
+		tBtnBatch batch;
+		uint32_t w;
+		if(!Btn_GetBatch(ev.evData, &batch))	{ (void)memset(&batch, 0, sizeof(batch)); }
+		for(w = 0; w < kBtnNumPortWords; ++w)
+		{
+			printf(" %llx/%llx/%llx/%llx", (unsigned long long)batch.pressed[w], (unsigned long long)batch.released[w],
+				(unsigned long long)batch.stuck[w], (unsigned long long)batch.unstuck[w]);
+		}
+	}
+#endif
+	printf("\n");
+	return kErr_Lib_NoError;
+}
+
+/** Not used; the inputs come from RandomSource(). */
+bool
+di_read_next_button_input_bit(uint32_t idx)
+{
+	UNUSED(idx);
+	return false;
+}
+
+/** Usage: btn_equiv [-c] [scans [seed]]
+ *	-c		draw every button's calibration at random, rather than use the defaults, and redraw it
+ *			every 5000 scans.
+ *	scans	scans to run; 200000 by default.
+ *	seed	seed of the random input (and calibration).
+ */
+int
+main(int argc, char *argv[])
+{
+	tEvQ_Event ev = { evButton_Task, 0 };
+	uint32_t scans = kEquivDefaultScans;
+	bool vary = false;
+	int argn = 1;
+	uint32_t n;
+
+	if((argn < argc) && !strcmp(argv[argn], "-c"))
+	{
+		vary = true;
+		++argn;
+	}
+	if(argn < argc)	{ scans = (uint32_t)strtoul(argv[argn++], NULL, 0); }
+	if(argn < argc)	{ seed = (uint32_t)strtoul(argv[argn++], NULL, 0); }
+
+	Btn_SetQueue(evButton_Task, &evqbtn);
+	Btn_SetInputSource(RandomSource);
+	if(vary)	{ VaryCalibration(); }
+#if (BTN_GESTURES)
+	SetGestures();
+#endif
+
+	for(n = 0; n < scans; ++n)
+	{
+		if(vary && n && !(n % kEquivRecalScans))	{ VaryCalibration(); }
+		Btn_tsk_ButtonRead(ev, 0);
+	}
+	fprintf(stderr, "%u scans, %u events\n", (unsigned)scans, (unsigned)evqbtn.numposted);
+	return EXIT_SUCCESS;
+}
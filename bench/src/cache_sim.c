@@ -0,0 +1,138 @@
+/** @file
+ *	@brief	A simulated L1 data cache, fed w/ the button engine's loads and stores, for counting cache
+ *	misses on hosts that expose no hardware counters.
+ *
+ *	The engine is compiled w/ GCC's `-fsanitize=thread`, which calls a hook before every load and
+ *	store; this file supplies those hooks in place of the ThreadSanitizer runtime, and passes each
+ *	access to a model of a typical x86 L1D: 32 KiB, 8-way set-associative, 64-byte lines, LRU. Only
+ *	the instrumented code is seen, so the misses are the engine's own, not the benchmark's.
+ *	bench/cache.sh builds it.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cache_sim.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum eCacheSimSizes {
+	kSimLineShift	= 6,			//!< 64-byte lines.
+	kSimWays		= 8,
+	kSimSets		= 64			//!< 64 sets of 8 ways of 64 bytes: 32 KiB.
+};
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+/** Lines held in each set, most recently used first; 0 for an empty way. A line is held as its
+ *	address plus one, so that no line is 0.
+ */
+static uintptr_t	sets[kSimSets][kSimWays];
+static uint64_t		misses = 0;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/** One access to one line: make it the set's most recent, loading it on a miss. */
+static void
+Access(uintptr_t line)
+{
+	uintptr_t *pset = sets[line % kSimSets];
+	uintptr_t tag = line + 1;
+	uint32_t way;
+
+	for(way = 0; (way < kSimWays - 1) && (pset[way] != tag); ++way)	{}
+	if(pset[way] != tag)	{ ++misses; }		// the least recent, evicted.
+	(void)memmove(&pset[1], &pset[0], way * sizeof(pset[0]));
+	pset[0] = tag;
+}
+
+/** An access of `size` bytes, on each line it spans. */
+static void
+Touch(void const volatile *p, size_t size)
+{
+	uintptr_t line = (uintptr_t)p >> kSimLineShift;
+	uintptr_t end = ((uintptr_t)p + (size ? size : 1) - 1) >> kSimLineShift;
+	for(; line <= end; ++line)	{ Access(line); }
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+uint64_t
+CacheSim_Misses(void)
+{
+	return misses;
+}
+
+// ----	Instrumentation hooks -----------------------------------------------
+// the entry points GCC's -fsanitize=thread calls; their names and signatures are the compiler's.
+
+void __tsan_init(void)						{}
+void __tsan_func_entry(void *pc)			{ (void)pc; }
+void __tsan_func_exit(void)					{}
+
+void __tsan_read1(void *p)					{ Touch(p, 1); }
+void __tsan_read2(void *p)					{ Touch(p, 2); }
+void __tsan_read4(void *p)					{ Touch(p, 4); }
+void __tsan_read8(void *p)					{ Touch(p, 8); }
+void __tsan_read16(void *p)					{ Touch(p, 16); }
+void __tsan_write1(void *p)					{ Touch(p, 1); }
+void __tsan_write2(void *p)					{ Touch(p, 2); }
+void __tsan_write4(void *p)					{ Touch(p, 4); }
+void __tsan_write8(void *p)					{ Touch(p, 8); }
+void __tsan_write16(void *p)				{ Touch(p, 16); }
+void __tsan_unaligned_read2(void *p)		{ Touch(p, 2); }
+void __tsan_unaligned_read4(void *p)		{ Touch(p, 4); }
+void __tsan_unaligned_read8(void *p)		{ Touch(p, 8); }
+void __tsan_unaligned_read16(void *p)		{ Touch(p, 16); }
+void __tsan_unaligned_write2(void *p)		{ Touch(p, 2); }
+void __tsan_unaligned_write4(void *p)		{ Touch(p, 4); }
+void __tsan_unaligned_write8(void *p)		{ Touch(p, 8); }
+void __tsan_unaligned_write16(void *p)		{ Touch(p, 16); }
+void __tsan_read_range(void *p, size_t n)	{ Touch(p, n); }
+void __tsan_write_range(void *p, size_t n)	{ Touch(p, n); }
+
+// the engine's published states use 32-bit atomics; the benchmark runs them on one thread.
+int
+__tsan_atomic32_load(int const volatile *p, int mo)
+{
+	(void)mo;
+	Touch(p, sizeof(*p));
+	return *p;
+}
+
+void
+__tsan_atomic32_store(int volatile *p, int v, int mo)
+{
+	(void)mo;
+	Touch(p, sizeof(*p));
+	*p = v;
+}
+
+void __tsan_atomic_thread_fence(int mo)		{ (void)mo; }
@@ -0,0 +1,40 @@
+/** @file
+ *	@brief	A simulated L1 data cache, fed w/ the button engine's loads and stores, for counting cache
+ *	misses on hosts that expose no hardware counters.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+#ifndef CACHE_SIM_H
+#define CACHE_SIM_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+/** Misses of the simulated cache since the program started. */
+extern uint64_t CacheSim_Misses(void);
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CACHE_SIM_H */
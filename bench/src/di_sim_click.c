@@ -0,0 +1,199 @@
+/** @file
+ *	@brief	Check of the simulated-DI timeline against the button engine: every way the desktop UIs
+ *	operate a button must debounce into the events the user meant.
+ *
+ *	Each case queues its operations on a timeline of its own button, scans the engine on a 10 ms
+ *	clock w/ di_sim_level_at() as the input source, and compares the events posted for the button w/
+ *	those expected. bench/click.sh builds and runs it for both engines.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_board.h"
+#include "cwsw_bsp_buttons.h"
+#include "cwsw_bsp_buttons_cfg.h"
+#include "cwsw_bsp_di_sim.h"
+
+// ----	Module Headers --------------------------
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum eClickSizes {
+	kClickScanMs	= 10,			//!< Scan period, in ms; the engine's default.
+	kClickScans		= 300,			//!< Scans run; 3 s, well past every case's last operation.
+	kClickMaxOps	= 4,			//!< Most operations in a case.
+	kClickMaxEvents	= 4				//!< Most events a case expects.
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/** One operation of a button: its new level, and the clock time (ms) at which it happens. */
+typedef struct sClickOp {
+	bool			level;
+	tCwswClockTics	when;
+} tClickOp;
+
+/** One case: the operations of a button, and the events they must post. */
+typedef struct sClickCase {
+	char const		*name;
+	tClickOp		op[kClickMaxOps];
+	uint32_t		numops;
+	uint16_t		expect[kClickMaxEvents];	//!< Event IDs, in order.
+	uint32_t		numexpect;
+} tClickCase;
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tClickCase const cases[] = {
+	{ "press and release at the same instant (GTK \"clicked\")",
+		{ { true, 1000 }, { false, 1000 } }, 2, { evBntPressed, evBtnReleased }, 2 },
+	{ "press, then release 200 ms later",
+		{ { true, 1000 }, { false, 1200 } }, 2, { evBntPressed, evBtnReleased }, 2 },
+	{ "release 15 ms into the press's bounce cuts it short",
+		{ { true, 1000 }, { false, 1015 } }, 2, { 0 }, 0 },
+	{ "two clicks at the same instant",
+		{ { true, 1000 }, { false, 1000 }, { true, 1000 }, { false, 1000 } }, 4,
+		{ evBntPressed, evBtnReleased, evBntPressed, evBtnReleased }, 4 },
+};
+
+static tEvQ_QueueCtrlEx evqbtn;
+static tCwswClockTics	now = 0;
+
+/** Events posted for each case's button. */
+static uint16_t			posted[TABLE_SIZE(cases)][kClickMaxEvents + 1];
+static uint32_t			numposted[TABLE_SIZE(cases)];
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/** Input source: every case's button, as its timeline has it now. */
+static void
+TimelineSource(tBtnPortWord inputs[kBtnNumPortWords])
+{
+	uint32_t idx;
+
+	(void)memset(inputs, 0, sizeof(tBtnPortWord) * kBtnNumPortWords);
+	for(idx = 0; idx < TABLE_SIZE(cases); ++idx)
+	{
+		if(di_sim_level_at(idx, now))	{ inputs[idx / kBtnBitsPerWord] |= (tBtnPortWord)1 << (idx % kBtnBitsPerWord); }
+	}
+}
+
+
+/** A full timeline refuses an operation, and keeps what it holds: here, a release 15 ms into the
+ *	last press, which would cut short that press's bounce, must not discard its last edge. Uses the
+ *	first button past the cases'.
+ *	@returns the number of failures.
+ */
+static uint32_t
+CheckFullTimeline(void)
+{
+	uint32_t const idx = TABLE_SIZE(cases);
+	tCwswClockTics when = 100000, last = 0;
+	bool level = true;
+	bool ok;
+
+	while(di_sim_add_transition(idx, level, when))
+	{
+		last = when;
+		level = !level;
+		when += 1000;
+	}
+
+	// the last operation queued, at `last`, set !level.
+	ok = !di_sim_add_transition(idx, level, last + 15) && (di_sim_level_at(idx, last + 1000) == !level);
+	printf("%s full timeline refuses an operation, and keeps its edges\n", ok ? "ok  " : "FAIL");
+	return ok ? 0 : 1;
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/** Stand-in for the event queue: record the event against its case. */
+int16_t
+Cwsw_EvQX__PostEvent(ptEvQ_QueueCtrlEx pEvQX, tEvQ_Event ev)
+{
+	++pEvQX->numposted;
+	if((ev.evData < TABLE_SIZE(cases)) && (numposted[ev.evData] <= kClickMaxEvents))
+	{
+		posted[ev.evData][numposted[ev.evData]++] = ev.evId;
+	}
+	return kErr_Lib_NoError;
+}
+
+/** Not used; the inputs come from TimelineSource(). */
+bool
+di_read_next_button_input_bit(uint32_t idx)
+{
+	UNUSED(idx);
+	return false;
+}
+
+int
+main(void)
+{
+	tEvQ_Event ev = { evButton_Task, 0 };
+	uint32_t c, n, failed = 0;
+
+	Btn_SetQueue(evButton_Task, &evqbtn);
+	Btn_SetInputSource(TimelineSource);
+	for(c = 0; c < TABLE_SIZE(cases); ++c)
+	{
+		for(n = 0; n < cases[c].numops; ++n)
+		{
+			if(!di_sim_add_transition(c, cases[c].op[n].level, cases[c].op[n].when))
+			{
+				printf("FAIL %s: operation %u not queued\n", cases[c].name, (unsigned)n);
+				++failed;
+			}
+		}
+	}
+
+	for(n = 0; n < kClickScans; ++n)
+	{
+		now += kClickScanMs;
+		Btn_tsk_ButtonRead(ev, 0);
+	}
+
+	for(c = 0; c < TABLE_SIZE(cases); ++c)
+	{
+		bool ok = (numposted[c] == cases[c].numexpect)
+				&& !memcmp(posted[c], cases[c].expect, cases[c].numexpect * sizeof(cases[c].expect[0]));
+		printf("%s %s:", ok ? "ok  " : "FAIL", cases[c].name);
+		for(n = 0; (n < numposted[c]) && (n <= kClickMaxEvents); ++n)
+		{
+			printf(" %s", (posted[c][n] == evBntPressed) ? "pressed" : (posted[c][n] == evBtnReleased) ? "released" : "other");
+		}
+		printf("%s\n", numposted[c] ? "" : " no events");
+		if(!ok)	{ ++failed; }
+	}
+	failed += CheckFullTimeline();
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,30 @@
+/** @file
+ *	@brief	Button events for the button-engine benchmark.
+ *
+ *	Stand-in for the project's configuration of the button module.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+#ifndef CWSW_BSP_BUTTONS_CFG_H
+#define CWSW_BSP_BUTTONS_CFG_H
+
+enum eButtonEvents {
+	evButton_Task = 1,
+	evBntPressed,
+	evBtnReleased,
+	evButton_BtnStuck,
+	evButton_BtnUnstuck,
+	evButton_Batch,
+	evButton_Chord,
+	evButton_LongPress,
+	evButton_DoubleClick,
+	evButton_Repeat,
+	evButton_Toggle
+};
+
+#endif /* CWSW_BSP_BUTTONS_CFG_H */
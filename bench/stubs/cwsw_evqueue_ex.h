@@ -0,0 +1,66 @@
+/** @file
+ *	@brief	Lightweight stand-in for the CWSW extended event queue and software alarms, for the
+ *			button-engine benchmark.
+ *
+ *	The benchmark supplies Cwsw_EvQX__PostEvent(); it counts events rather than queueing them.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+#ifndef CWSW_EVQUEUE_EX_H
+#define CWSW_EVQUEUE_EX_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	Project Headers -------------------------
+#include "cwsw_lib.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum eTmrState {
+	kTmrState_Disabled,
+	kTmrState_Enabled
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+typedef int32_t		tEvQ_EventID;
+
+typedef struct sEvQ_Event {
+	tEvQ_EventID	evId;
+	uint32_t		evData;
+} tEvQ_Event, *ptEvQ_Event;
+
+typedef struct sEvQ_QueueCtrlEx {
+	uint32_t		numposted;		//!< Events posted to this queue.
+} tEvQ_QueueCtrlEx, *ptEvQ_QueueCtrlEx;
+
+/** Software alarm, as kept by the OS timer service. */
+typedef struct sCwswSwAlarm {
+	tCwswClockTics		tm;
+	tCwswClockTics		reloadtm;
+	ptEvQ_QueueCtrlEx	pEvQX;
+	tEvQ_EventID		evid;
+	enum eTmrState		tmrstate;
+} tCwswSwAlarm;
+
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+extern int16_t Cwsw_EvQX__PostEvent(ptEvQ_QueueCtrlEx pEvQX, tEvQ_Event ev);
+
+#endif /* CWSW_EVQUEUE_EX_H */
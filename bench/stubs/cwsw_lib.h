@@ -0,0 +1,62 @@
+/** @file
+ *	@brief	Lightweight stand-in for the CWSW Library, for the button-engine benchmark.
+ *
+ *	Carries only what the button engine and the board headers use.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+#ifndef CWSW_LIB_H
+#define CWSW_LIB_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum eErrorCodes_Lib {
+	kErr_Lib_NoError,
+	kErr_Lib_NotInitialized,
+	kErr_Lib_BadParm
+};
+
+/** Clock tics for common periods; the clock counts ms. */
+enum eCwswClockPeriods {
+	tmr10ms		= 10,
+	tmr100ms	= 100,
+	tmr500ms	= 500,
+	tmr1000ms	= 1000
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+typedef int32_t		tCwswClockTics;
+
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+#define UNUSED(x)			(void)(x)
+#define TABLE_SIZE(t)		(sizeof(t) / sizeof((t)[0]))
+
+#define Init(component)		component##__Init()
+#define Get(component, rsc)	component##__Get_##rsc()
+
+#endif /* CWSW_LIB_H */
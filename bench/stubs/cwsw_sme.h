@@ -0,0 +1,36 @@
+/** @file
+ *	@brief	Lightweight stand-in for the CWSW State Machine Engine, for the button-engine benchmark.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+#ifndef CWSW_SME_H
+#define CWSW_SME_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	Project Headers -------------------------
+#include "cwsw_evqueue_ex.h"
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/** Phases of a state function. */
+typedef enum eStateReturnCodes {
+	kStateUninit,
+	kStateOperational,
+	kStateExit,
+	kStateFinished
+} tStateReturnCodes;
+
+typedef tStateReturnCodes	(*pfStateHandler)(ptEvQ_Event pev, uint32_t *pextra);
+
+#endif /* CWSW_SME_H */
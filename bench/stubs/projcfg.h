@@ -0,0 +1,17 @@
+/** @file
+ *	@brief	Project configuration for the button-engine benchmark.
+ *
+ *	Stand-in for the project's projcfg.h. Engine options (BTN_ENGINE, BTN_BATCH_EVENTS, ...) are given
+ *	on the command line; see bench/readme.md.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+#ifndef PROJCFG_H
+#define PROJCFG_H
+
+#endif /* PROJCFG_H */
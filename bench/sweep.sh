@@ -0,0 +1,21 @@
+#!/bin/sh
+# Build and run the button-engine benchmark for each engine and button count.
+# Usage: bench/sweep.sh [extra compiler flags...]    e.g. bench/sweep.sh -march=native
+# CC, and the button counts (BUTTONS), may be overridden from the environment.
+
+cd "$(dirname "$0")/.." || exit 1
+CC=${CC:-gcc}
+BUTTONS=${BUTTONS:-"8 64 256 512 4096 65536"}
+OUT=${TMPDIR:-/tmp}/btn_bench.$$
+
+header=-H
+for engine in 0 1; do
+	for n in $BUTTONS; do
+		$CC -O2 -std=gnu11 -Wall -Wextra -DBTN_ENGINE=$engine -DBENCH_NUM_BUTTONS=$n "$@" \
+			-Ibench -Ibench/stubs -Icommon \
+			bench/src/btn_bench.c common/src/cwsw_bsp_buttons.c -o "$OUT" || exit 1
+		"$OUT" $header || exit 1
+		header=
+	done
+done
+rm -f "$OUT"
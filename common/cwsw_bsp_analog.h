@@ -0,0 +1,133 @@
+/** @file
+ *	@brief	Analog input acquisition common to all boards w/ analog inputs: block sampling, filtering,
+ *	decimation, and publication of the latest values.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+#ifndef CWSW_BSP_ANALOG_H
+#define CWSW_BSP_ANALOG_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+#include "projcfg.h"
+#include "cwsw_board.h"			/* kBoardNumAnalogs, BOARD_ANALOG */
+
+// ----	Module Headers --------------------------
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/** The board has analog inputs: it enumerates them in `eBoardAnalogs`, gives their sampling rate in
+ *	`kBoardAnalogRateHz`, and supplies ai_read_samples(). Boards w/o them build none of this module.
+ */
+#if !defined(BOARD_ANALOG)
+#define BOARD_ANALOG		0
+#endif
+
+/** Frames (one sample of every channel) asked of ai_read_samples() at a time. Each block is filtered
+ *	in one pass, a few channels per instruction, w/o a call per sample.
+ */
+#if !defined(AIN_BLOCK_FRAMES)
+#define AIN_BLOCK_FRAMES	32
+#endif
+
+/** Length of the moving average, in frames; a power of 2, at most 32768. 1 turns it off. */
+#if !defined(AIN_MA_TAPS)
+#define AIN_MA_TAPS			8
+#endif
+
+/** First-order IIR low-pass after the moving average: each frame moves the output 1 / 2^n of the way
+ *	to the input. At most 15; 0 turns it off. The time constant is about 2^n frames.
+ */
+#if !defined(AIN_IIR_SHIFT)
+#define AIN_IIR_SHIFT		2
+#endif
+
+/** Frames per published value; the filtered signal is decimated by this factor. */
+#if !defined(AIN_DECIMATE)
+#define AIN_DECIMATE		4
+#endif
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/** Observer of the raw frames, called once per block before it is filtered.
+ *	@param[in]	pframes	`nframes` frames of kBoardNumAnalogs samples, back to back, oldest first.
+ *	@param[in]	nframes	Frames in the block; at most #AIN_BLOCK_FRAMES.
+ */
+typedef void (*pfAinBlockTap)(uint16_t const *pframes, uint32_t nframes);
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+#if (BOARD_ANALOG)
+extern tCwswSwAlarm	Ain_tmr_Acquire;	// exposed mostly for OS scheduler
+
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+/** Set the event queue and event ID of the acquisition alarm. */
+extern void Ain_SetQueue(tEvQ_EventID const evid, const ptEvQ_QueueCtrlEx pEvqx);
+
+/** Watch the raw frames of every block (e.g., to decode a resistor-ladder keypad; see
+ *	cwsw_bsp_ladder.h). The tap runs in the acquisition task.
+ *	@param[in]	pftap	Observer; NULL for none.
+ */
+extern void Ain_SetBlockTap(pfAinBlockTap pftap);
+
+/** Acquisition task: read every frame the board has sampled since the last call, in blocks of
+ *	#AIN_BLOCK_FRAMES; filter, decimate, and publish the latest value of every channel. Call it often
+ *	enough that the board's sample buffer doesn't overflow.
+ */
+extern void Ain_tsk_Acquire(tEvQ_Event ev, uint32_t extra);
+
+/** Latest filtered value of every channel, as one snapshot. Callable from any thread (or ISR) while
+ *	the task runs; the values are published the same way as the button states, and read w/ the same
+ *	guarantee (see Btn_GetButtonStates()): lock-free, retrying only when lapped by the task. An ISR
+ *	that preempts the acquisition task on the task's core cannot be lapped, and never retries. One
+ *	the task can preempt (e.g., if the task itself runs from a higher-priority ISR) may; don't read
+ *	from such an ISR.
+ *	@param[out]	values	Destination, one value per channel, in ADC counts.
+ *	@returns the number of values published since startup, which wraps (and skips 0); 0 before the
+ *	first.
+ */
+extern uint32_t Ain_GetAll(uint16_t values[kBoardNumAnalogs]);
+
+/** Latest filtered value of one channel; lock-free, and callable from the same places, as
+ *	Ain_GetAll().
+ *	@param[in]	ch	Channel, one of the board's `eBoardAnalogs` values.
+ *	@returns the value, in ADC counts; 0 for a bad channel, or before the first value is published.
+ */
+extern uint16_t Ain_Get(uint32_t ch);
+#endif
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_BSP_ANALOG_H */
@@ -15,9 +15,13 @@
 // ============================================================================
 
 // ----	System Headers --------------------------
+#include <stdint.h>
+#include <stddef.h>				/* size_t */
 
 // ----	Project Headers -------------------------
+#include "projcfg.h"
 #include "cwsw_sme.h"
+#include "cwsw_board.h"			/* kBoardNumButtons */
 
 // ----	Module Headers --------------------------
 
@@ -31,16 +35,357 @@ extern "C" {
 // ----	Constants -------------------------------------------------------------
 // ============================================================================
 
+/** Debounce engine selections for #BTN_ENGINE.
+ *	@{
+ */
+#define BTN_ENGINE_SME					0	//!< One SME instance per button (default).
+#define BTN_ENGINE_VERTICAL_COUNTER		1	//!< Bit-sliced vertical counters, one port word at a time.
+/** @} */
+
+/** Debounce engine used by Btn_tsk_ButtonRead().
+ *	Both engines post the same button events (evBntPressed, evBtnReleased, evButton_BtnStuck,
+ *	evButton_BtnUnstuck) on the same scans; bench/equiv.sh checks that they do. The vertical-counter
+ *	engine is the per-button SME bit-sliced, stepping a full port word of buttons (four, w/ AVX2) with
+ *	one set of logic operations, whether one of them is busy or all are, and skipping words whose
+ *	buttons are all idle. The SME engine skips idle buttons, and steps the others one by one; it is the
+ *	faster of the two while few buttons are busy at once. The vertical counters pay off on banks where
+ *	most buttons change at once (see bench/readme.md). They debounce only w/ the shift-register rule.
+ *	Override via command line or projcfg.h.
+ */
+#if !defined(BTN_ENGINE)
+#define BTN_ENGINE		BTN_ENGINE_SME
+#endif
+
+/** Collect a whole scan's button changes into one batch event.
+ *	When enabled, Btn_tsk_ButtonRead() posts at most one `evButton_Batch` event per scan in place of
+ *	the individual press / release / stuck / unstuck events; its evData is the batch's sequence
+ *	number, to be handed to Btn_GetBatch(). The project defines `evButton_Batch` alongside the other
+ *	button events.
+ */
+#if !defined(BTN_BATCH_EVENTS)
+#define BTN_BATCH_EVENTS	0
+#endif
+
+/** Number of batches retained for Btn_GetBatch(); a batch remains available until this many later
+ *	batches have been posted.
+ */
+#if !defined(BTN_BATCH_DEPTH)
+#define BTN_BATCH_DEPTH		4
+#endif
+
+/** Learn each button's bounce online, and fit its debounce window to it.
+ *	Each debounce measures the longest stretch of steady samples that was followed by another bounce;
+ *	the button's window is kept just longer than the longest such stretch seen, between
+ *	#BTN_ADAPT_MIN_SAMPLES and the calibrated window. The learned windows can be saved and restored
+ *	with Btn_GetBounceProfile() and Btn_SetBounceProfile(). SME engine only.
+ */
+#if !defined(BTN_ADAPTIVE_DEBOUNCE)
+#define BTN_ADAPTIVE_DEBOUNCE	0
+#endif
+
+/** Narrowest window, in scans, adaptive debounce will use. */
+#if !defined(BTN_ADAPT_MIN_SAMPLES)
+#define BTN_ADAPT_MIN_SAMPLES	2
+#endif
+
+#if (BTN_ADAPTIVE_DEBOUNCE) && (BTN_ENGINE != BTN_ENGINE_SME)
+#error "Adaptive debounce (BTN_ADAPTIVE_DEBOUNCE) requires the SME engine"
+#endif
+
+/** Measure each button's edge-to-event latency: from the scan that sees the first edge of a change,
+ *	to the scan that posts its press or release event. Query with Btn_GetLatency(). Costs about
+ *	460 bytes of RAM per button. SME engine only.
+ */
+#if !defined(BTN_LATENCY_STATS)
+#define BTN_LATENCY_STATS	0
+#endif
+
+#if (BTN_LATENCY_STATS) && (BTN_ENGINE != BTN_ENGINE_SME)
+#error "Latency statistics (BTN_LATENCY_STATS) require the SME engine"
+#endif
+
+/** Profile each button's SM: the times each transition-table row is taken, and the scans spent in
+ *	each state. Dump with Btn_DumpProfile(). SME engine only.
+ */
+#if !defined(BTN_PROFILE)
+#define BTN_PROFILE		0
+#endif
+
+#if (BTN_PROFILE) && (BTN_ENGINE != BTN_ENGINE_SME)
+#error "The SM profiler (BTN_PROFILE) requires the SME engine"
+#endif
+
+/** Recognize chords: registered sets of buttons pressed together, reported as one `evButton_Chord`
+ *	event (evData: the chord's ID) when they're released. See Btn_SetChords(). The project defines
+ *	`evButton_Chord` alongside the other button events.
+ */
+#if !defined(BTN_CHORDS)
+#define BTN_CHORDS		0
+#endif
+
+/** Size of the chord table's hash index; a power of 2. Holds up to half this many chords. */
+#if !defined(BTN_CHORD_SLOTS)
+#define BTN_CHORD_SLOTS	32
+#endif
+
+/** Recognize gestures: long-press, double-click, auto-repeat and latching toggle, configured per
+ *	button by Btn_SetGestures(). They're posted as `evButton_LongPress`, `evButton_DoubleClick`,
+ *	`evButton_Repeat` and `evButton_Toggle` (evData: the button ID; see #kBtnToggledOn), in addition to
+ *	the press and release events. The project defines these events alongside the other button events.
+ */
+#if !defined(BTN_GESTURES)
+#define BTN_GESTURES	0
+#endif
+
+/** Button engine instances available from Btn_CtxCreate(), beyond the default instance that serves
+ *	the board's own buttons. Each instance is sized for kBoardNumButtons buttons, and takes that
+ *	instance's share of RAM whether or not it is created.
+ */
+#if !defined(BTN_INSTANCES)
+#define BTN_INSTANCES	0
+#endif
+
+/** Worker threads that help scan each instance, besides the thread that calls the scan task (SME
+ *	engine, POSIX hosts). A scan splits the buttons into shards of #BTN_SHARD_WORDS port words, which
+ *	the threads share out between them, stealing from each other as their own share runs out; the
+ *	events are then posted by the calling thread, in the same order as a single-threaded scan.
+ *	Only worth it for banks of thousands of buttons. Link w/ -pthread.
+ */
+#if !defined(BTN_SCAN_THREADS)
+#define BTN_SCAN_THREADS	0
+#endif
+
+/** Port words per scan shard. A multiple of 8 (one 64-byte cache line of port words), so no two
+ *	shards share a cache line.
+ */
+#if !defined(BTN_SHARD_WORDS)
+#define BTN_SHARD_WORDS		8
+#endif
+
+#if (BTN_SCAN_THREADS) && (BTN_ENGINE != BTN_ENGINE_SME)
+#error "Threaded scans (BTN_SCAN_THREADS) require the SME engine"
+#endif
+
+#if (BTN_SCAN_THREADS) && !(defined(__unix__) || defined(__APPLE__))
+#error "Threaded scans (BTN_SCAN_THREADS) require POSIX threads"
+#endif
+
+/** Scan groups: sets of buttons sampled at their own rates, e.g. a stop input every 1 ms and the
+ *	panel switches every 50 ms. Each button's calibration names its group; each group's period is set
+ *	by Btn_SetScanGroup(). The scan task runs at the rate of the fastest group, and steps a button's
+ *	SM only on the scans that sample it, so slow groups cost next to nothing in between. Debounce
+ *	windows and timeouts are in ms, and are converted at each group's own rate. 0 for no groups (every
+ *	button is sampled on every scan). SME engine only.
+ */
+#if !defined(BTN_SCAN_GROUPS)
+#define BTN_SCAN_GROUPS		0
+#endif
+
+#if (BTN_SCAN_GROUPS) && (BTN_ENGINE != BTN_ENGINE_SME)
+#error "Scan groups (BTN_SCAN_GROUPS) require the SME engine"
+#endif
+
+/** Specialize the SME engine for the board at compile time, for the fastest scan on small MCUs:
+ *	- states, debounce rules and transitions are called directly (so the compiler can inline them),
+ *	  rather than through tables of function pointers;
+ *	- the scan is unrolled over the board's buttons;
+ *	- buttons outside #BTN_WIRED_MASK are never read, scanned or reported.
+ *	The API is unchanged. For boards of up to #kBtnBitsPerWord buttons (one port word).
+ */
+#if !defined(BTN_SPECIALIZE)
+#define BTN_SPECIALIZE	0
+#endif
+
+/** Buttons wired to an input, by button ID; used by #BTN_SPECIALIZE. A board whose button IDs
+ *	include placeholders (e.g., kBoardButtonNone) leaves them out. Default: every button.
+ */
+#if !defined(BTN_WIRED_MASK)
+#define BTN_WIRED_MASK	(~(uint64_t)0)
+#endif
+
+#if (BTN_SPECIALIZE) && (BTN_ENGINE != BTN_ENGINE_SME)
+#error "The specialized engine (BTN_SPECIALIZE) is the SME engine"
+#endif
+
+/** Pack each button's SME state for small-RAM parts: phase and exit reasons in a byte each, an 8-bit
+ *	sample history (so debounce windows of up to 8 samples), and the state timer as a 16-bit deadline
+ *	relative to the scan count (so timeouts of up to 32767 scans: over 5 minutes at 10 ms). Running
+ *	timers are checked on every scan rather than filed in a timing wheel, which also saves the wheel's
+ *	slots. About 10 bytes per button all told at 256 buttons (2.3 KB), against 40; see Btn_RamPerButton.
+ *	SME engine only.
+ */
+#if !defined(BTN_COMPACT)
+#define BTN_COMPACT		0
+#endif
+
+#if (BTN_COMPACT) && (BTN_ENGINE != BTN_ENGINE_SME)
+#error "Compact button state (BTN_COMPACT) requires the SME engine"
+#endif
+
+/** Most RAM per button, in bytes, that the build may take (see Btn_RamPerButton); the build fails if
+ *	the features built in take more. 0 for no limit.
+ */
+#if !defined(BTN_RAM_PER_BUTTON_MAX)
+#define BTN_RAM_PER_BUTTON_MAX	0
+#endif
+
+/** Build Btn_MapCalibration(), which maps a calibration image file into memory (POSIX hosts).
+ *	MCU builds link their calibration image or table, and hand it to Btn_SetCalibrationImage() or
+ *	Btn_SetCalibration().
+ */
+#if !defined(BTN_CAL_MMAP)
+#if defined(__unix__) || defined(__APPLE__)
+#define BTN_CAL_MMAP	1
+#else
+#define BTN_CAL_MMAP	0
+#endif
+#endif
+
+enum eBtnPortWords {
+	kBtnBitsPerWord		= 64,												//!< Button inputs per port word.
+	kBtnNumPortWords	= (kBoardNumButtons + kBtnBitsPerWord - 1) / kBtnBitsPerWord	//!< Port words needed to hold all button inputs.
+};
+
+/** Calibration image identification. */
+enum eBtnCalImage {
+	kBtnCalMagic	= 0x4C414342,		//!< "BCAL", read as a little-endian uint32_t.
+	kBtnCalVersion	= 1					//!< Layout of tBtnCalImageHdr and tBtnCalibration.
+};
+
+/** Button ID that selects all buttons together, for Btn_GetLatency(). */
+enum { kBtnLatencyAllButtons = 0xFFFFFFFFu };
+
+/** Set in the evData of `evButton_Toggle` when the button's latch has turned on. */
+enum { kBtnToggledOn = 0x80000000u };
+
+/** Longest debounce window, in samples, that the debouncers can count. */
+#if (BTN_COMPACT)
+enum { kBtnMaxDebounceSamples = 8 };
+#else
+enum { kBtnMaxDebounceSamples = 32 };
+#endif
+
+/** Debounce rules the SME engine can apply to a button; chosen per button by its calibration.
+ *	All share the same state machine and post the same events; they differ in how a noisy input is
+ *	judged to have settled. "Window" is the button's press or release window, in scans.
+ *	The vertical-counter engine applies the shift-register rule to every button, whatever its calibration.
+ */
+enum eBtnDebounceStrategy {
+	kBtnDebounceShiftRegister,	//!< The last `window` samples all agree. Default.
+	kBtnDebounceIntegrator,		//!< A count, up for "pressed" samples and down for "released", reaches +/- `window`. Rides through isolated glitches.
+	kBtnDebounceMajority,		//!< At least 3/4 of the last `window` samples agree. Tolerates sustained noise.
+	kBtnNumDebounceStrategies
+};
+
+
 // ============================================================================
 // ----	Type Definitions ------------------------------------------------------
 // ============================================================================
 
+/** One "port word" of button inputs; bit n of word w holds button (w * #kBtnBitsPerWord) + n. */
+typedef uint64_t	tBtnPortWord;
+
+/** Calibration of one button.
+ *	Windows are given in ms and rounded down to whole samples of the button's input (at least one): one
+ *	per scan, or w/ #BTN_SCAN_GROUPS, one per period of the button's group. The debouncers count up to
+ *	#kBtnMaxDebounceSamples samples. The layout is fixed, as it is also the record format of the
+ *	calibration image.
+ */
+typedef struct sBtnCalibration {
+	uint16_t	tmPressDebounce;	//!< Time the input must read "pressed", without a break, to be recognized as pressed.
+	uint16_t	tmReleaseDebounce;	//!< Time the input must read "released", without a break, to be recognized as released.
+	uint32_t	tmStuck;			//!< Time a button may be held before it is reported stuck.
+	uint8_t		enabled;			//!< 0 excludes the button from scanning; it never posts an event.
+	uint8_t		strategy;			//!< Debounce rule (#eBtnDebounceStrategy); SME engine only.
+	uint8_t		group;				//!< Scan group (below #BTN_SCAN_GROUPS; else group 0); 0 in images written before groups.
+	uint8_t		reserved[1];		//!< Pad to a multiple of 4 bytes; write as 0.
+} tBtnCalibration;
+
+/** Header of a calibration image.
+ *	The image is this header, followed directly by `numbuttons` tBtnCalibration records, in button-ID
+ *	order, in the target's native byte order. It is used in place, so it must stay mapped (or
+ *	resident) for as long as it is in use.
+ */
+typedef struct sBtnCalImageHdr {
+	uint32_t	magic;				//!< #kBtnCalMagic.
+	uint16_t	version;			//!< #kBtnCalVersion.
+	uint16_t	numbuttons;			//!< Number of records; must equal kBoardNumButtons.
+	uint16_t	recsize;			//!< sizeof(tBtnCalibration).
+	uint16_t	reserved;			//!< Write as 0.
+} tBtnCalImageHdr;
+
+/** The button changes recognized in one scan, as bitmaps indexed like port words. */
+typedef struct sBtnBatch {
+	tBtnPortWord	pressed[kBtnNumPortWords];		//!< Buttons that became pressed (evBntPressed).
+	tBtnPortWord	released[kBtnNumPortWords];		//!< Buttons that became released (evBtnReleased).
+	tBtnPortWord	stuck[kBtnNumPortWords];		//!< Buttons reported stuck (evButton_BtnStuck).
+	tBtnPortWord	unstuck[kBtnNumPortWords];		//!< Buttons no longer stuck (evButton_BtnUnstuck).
+} tBtnBatch;
+
+/** Debounced state of every button as of the end of one scan, as bitmaps indexed like port words. */
+typedef struct sBtnStates {
+	tBtnPortWord	pressed[kBtnNumPortWords];		//!< Debounced "pressed", stuck buttons included.
+	tBtnPortWord	stuck[kBtnNumPortWords];		//!< Reported stuck, and not yet released.
+	uint32_t		scan;							//!< Scan that published the snapshot; counts from 1.
+} tBtnStates;
+
+/** Edge-to-event latency summary. Times are in ms, at scan resolution; percentiles are the upper
+ *	bound of their histogram bucket, so err on the slow side by at most 1/8.
+ */
+typedef struct sBtnLatencyStats {
+	uint32_t	count;				//!< Press and release events measured.
+	uint32_t	p50;				//!< Median latency.
+	uint32_t	p99;				//!< 99th-percentile latency.
+	uint32_t	max;				//!< Longest latency.
+} tBtnLatencyStats;
+
+/** One chord: a set of buttons pressed together. */
+typedef struct sBtnChord {
+	tBtnPortWord	buttons[kBtnNumPortWords];	//!< Buttons that make up the chord (two or more).
+	uint32_t		id;							//!< evData of the chord's `evButton_Chord` event.
+} tBtnChord;
+
+/** Gestures recognized on one button. Times are in ms, rounded down to whole scans (at least one);
+ *	a time of 0 turns its gesture off.
+ */
+typedef struct sBtnGesture {
+	uint16_t	tmLongPress;		//!< Hold time that posts `evButton_LongPress`, once per press.
+	uint16_t	tmDoubleClick;		//!< Longest time from the release of one click to the next press, for `evButton_DoubleClick`.
+	uint16_t	tmRepeatDelay;		//!< Hold time before the first `evButton_Repeat`.
+	uint16_t	tmRepeatRate;		//!< Time between further repeats, while held.
+	uint8_t		toggle;				//!< Non-0: each press flips a latch, and posts `evButton_Toggle`.
+	uint8_t		reserved[3];		//!< Write as 0.
+} tBtnGesture;
+
+/** One button engine instance: a bank of buttons w/ its own SM state, calibration, input source and
+ *	event queue. Opaque; instances come from Btn_CtxCreate() and Btn_GetDefaultCtx().
+ */
+typedef struct sBtnCtx tBtnCtx;
+typedef tBtnCtx *ptBtnCtx;
+
+/** Text sink for dumps; the text arrives in pieces, to be written out in order. */
+typedef void (*pfBtnTextOut)(char const *ptext);
+
+/** Source of a scan's button inputs: fills in every port word. */
+typedef void (*pfBtnInputSource)(tBtnPortWord inputs[kBtnNumPortWords]);
+
+/** Observer of a scan's button inputs, called once they have been read. */
+typedef void (*pfBtnInputTap)(tBtnPortWord const inputs[kBtnNumPortWords]);
+
 // ============================================================================
 // ----	Public Variables ------------------------------------------------------
 // ============================================================================
 
 extern tCwswSwAlarm	Btn_tmr_ButtonRead;	// exposed mostly for OS scheduler
 
+/** RAM taken by one engine instance, as built: in all, and divided among its kBoardNumButtons
+ *	buttons. Fixed at compile time; here for the map file and the debugger.
+ *	@{
+ */
+extern size_t const	Btn_RamPerInstance;
+extern size_t const	Btn_RamPerButton;
+/** @} */
+
 
 // ============================================================================
 // ----	Public API ------------------------------------------------------------
@@ -49,6 +394,241 @@ extern tCwswSwAlarm	Btn_tmr_ButtonRead;	// exposed mostly for OS scheduler
 extern void Btn_SetQueue(tEvQ_EventID const evid, const ptEvQ_QueueCtrlEx pEvqx);
 extern void Btn_tsk_ButtonRead(tEvQ_Event evid, uint32_t extra);
 
+/** Use a calibration table in place of the compiled-in default.
+ *	The table is used in place; it must remain valid until replaced. Windows are converted to scans
+ *	at the current rate of Btn_tmr_ButtonRead, so call this again after changing the scan rate.
+ *	@param[in]	pcal	Table of kBoardNumButtons records, indexed by button ID; NULL restores the
+ *						compiled-in default for every button.
+ */
+extern void Btn_SetCalibration(tBtnCalibration const *pcal);
+
+/** Validate a calibration image and, if good, use its records in place.
+ *	@param[in]	pimage	Start of the image.
+ *	@param[in]	size	Size of the image, in bytes.
+ *	@returns false if the image is malformed or is for a different board; the calibration in use is
+ *	left unchanged.
+ */
+extern bool Btn_SetCalibrationImage(void const *pimage, size_t size);
+
+#if (BTN_CAL_MMAP)
+/** Map a calibration image file read-only, and use it via Btn_SetCalibrationImage().
+ *	A previously mapped image is released once it has been replaced.
+ *	@param[in]	path	Image file.
+ *	@returns false if the file can't be mapped, or the image is rejected.
+ */
+extern bool Btn_MapCalibration(char const *path);
+#endif
+
+#if (BTN_ADAPTIVE_DEBOUNCE)
+/** Save the learned debounce windows.
+ *	@param[out]	ptm		Learned window of each button, in ms, indexed by button ID; 0 for a button
+ *						with nothing learned yet.
+ */
+extern void Btn_GetBounceProfile(uint16_t ptm[kBoardNumButtons]);
+
+/** Restore debounce windows saved by Btn_GetBounceProfile().
+ *	Windows are converted to scans at the current scan rate, and bounded as for learning.
+ *	@param[in]	ptm		Window of each button, in ms, indexed by button ID; 0 forgets the button's
+ *						profile, so that it starts over from its calibrated window.
+ */
+extern void Btn_SetBounceProfile(uint16_t const ptm[kBoardNumButtons]);
+#endif
+
+#if (BTN_LATENCY_STATS)
+/** Summarize the edge-to-event latencies measured so far.
+ *	@param[in]	idx		Button ID, or #kBtnLatencyAllButtons for all buttons together.
+ *	@param[out]	pstats	Destination for the summary.
+ *	@returns false if the button ID is invalid.
+ */
+extern bool Btn_GetLatency(uint32_t idx, tBtnLatencyStats *pstats);
+
+/** Discard the latencies measured so far. */
+extern void Btn_ResetLatency(void);
+#endif
+
+#if (BTN_PROFILE)
+/** Dump the SM profile as CSV: a header line, then one line per button.
+ *	Columns are the button ID; scans spent in each state ("st:<state>"), including the current stay;
+ *	then the count of each transition-table row ("tr:<state>/<reason1>/<reason3>><next state>").
+ *	@param[in]	pfout	Text sink, e.g. a wrapper around fputs().
+ *	@returns false if no sink is given.
+ */
+extern bool Btn_DumpProfile(pfBtnTextOut pfout);
+
+/** Zero the SM profile. */
+extern void Btn_ResetProfile(void);
+#endif
+
+#if (BTN_CHORDS)
+/** Register the chords to recognize.
+ *	A press of a button that belongs to a chord is held back for the coincidence window. If, when the
+ *	window closes (or one of the held buttons is released), the held presses are exactly one of the
+ *	chords, the chord's event is posted on the first release of one of its buttons, in place of its
+ *	buttons' press and release events. Otherwise, the held presses are posted, late by up to the
+ *	window. Buttons in no chord are not delayed.
+ *	@param[in]	ptbl		Chord table; used in place, so it must remain valid until replaced. NULL
+ *							(w/ a count of 0) stops chord recognition.
+ *	@param[in]	count		Number of chords; at most #BTN_CHORD_SLOTS / 2.
+ *	@param[in]	tmwindow	Coincidence window (ms): the time from the first press of a chord to the
+ *							last.
+ *	@returns false if the table is too long, or holds a chord of fewer than 2 buttons, or the same
+ *	chord twice; no chords are recognized until a valid table is registered.
+ */
+extern bool Btn_SetChords(tBtnChord const *ptbl, uint32_t count, uint32_t tmwindow);
+#endif
+
+#if (BTN_GESTURES)
+/** Configure the gestures to recognize, and clear all gesture state (including toggle latches).
+ *	A press that was part of a double-click, or that posted a long-press or a repeat, doesn't count as
+ *	the first click of a double-click. A stuck button's gestures are cancelled.
+ *	@param[in]	ptbl	Table of kBoardNumButtons records, indexed by button ID; used in place, so it
+ *						must remain valid until replaced. NULL turns gestures off.
+ */
+extern void Btn_SetGestures(tBtnGesture const *ptbl);
+#endif
+
+#if (BTN_SCAN_GROUPS)
+/** Set the sampling period of one scan group.
+ *	The period is rounded down to whole scans of Btn_tmr_ButtonRead (at least one), whose reload time
+ *	must therefore be that of the fastest group. Groups start out sampled on every scan. A button whose
+ *	SM is mid-debounce when its group's period changes finishes that debounce at the new rate.
+ *	@param[in]	group		Group, below #BTN_SCAN_GROUPS.
+ *	@param[in]	tmperiod	Period, in ms; 0 samples the group on every scan.
+ *	@returns false if the group is out of range.
+ */
+extern bool Btn_SetScanGroup(uint32_t group, uint16_t tmperiod);
+#endif
+
+/** Number of button events (or batch events) the event queue refused. */
+extern uint32_t Btn_GetPostFailures(void);
+
+/** Take button inputs from somewhere other than the board's DI (e.g., a recorded trace).
+ *	@param[in]	pfsource	Input source, called once at the start of every scan; NULL returns to
+ *							di_read_next_button_input_bit().
+ */
+extern void Btn_SetInputSource(pfBtnInputSource pfsource);
+
+/** Watch the button inputs of every scan (e.g., to record them).
+ *	@param[in]	pftap	Observer, called once per scan after the inputs are read; NULL for none.
+ */
+extern void Btn_SetInputTap(pfBtnInputTap pftap);
+
+/** Take a snapshot of the debounced state of every button, as of the most recent scan; for clients
+ *	that poll state rather than follow the events. Callable from any thread (or ISR) while the buttons
+ *	are being scanned: each scan publishes its snapshot through a double-buffered sequence lock, so a
+ *	reader never waits on a scan in progress. It is lock-free, not wait-free: a reader takes another
+ *	copy if it is lapped, i.e., if a scan completes and the next starts to overwrite the copy being
+ *	read, and retries for as long as that keeps happening. A reader that preempts the scan on the
+ *	scan's own core (an ISR, or a higher-priority task) cannot be lapped, and always finishes in one
+ *	pass; one the scan can preempt, or on another core, may not.
+ *	@param[out]	pstates	Destination for the snapshot.
+ *	@returns false before the first scan.
+ */
+extern bool Btn_GetButtonStates(tBtnStates *pstates);
+
+/** Target for `Get(Cwsw_Board, ButtonStates)`: Btn_GetButtonStates(), by value; all buttons read
+ *	released before the first scan.
+ */
+extern tBtnStates Cwsw_Board__Get_ButtonStates(void);
+
+#if (BTN_BATCH_EVENTS)
+/** Retrieve the changes carried by one `evButton_Batch` event.
+ *	@param[in]	seq		Batch sequence number, from the event's evData.
+ *	@param[out]	pbatch	Destination for the batch.
+ *	@returns false if the batch is unknown, or has been overwritten by newer batches.
+ */
+extern bool Btn_GetBatch(uint32_t seq, tBtnBatch *pbatch);
+#endif
+
+
+
+/* ---- Instances -----------------------------------------------------------
+ * Every function above works on the default instance: the board's own buttons, read through its DI
+ * and scanned by Btn_tmr_ButtonRead. Each has a Btn_Ctx... counterpart that works on any instance,
+ * so several banks (front panel, rear panel, expander boards) can run side by side. An instance
+ * shares nothing w/ another, so different instances may be scanned on different threads; any one
+ * instance must be used by one thread at a time, except by Btn_CtxGetButtonStates().
+ */
+
+#if (BTN_INSTANCES)
+/** Create an instance, from a pool of #BTN_INSTANCES. Not thread-safe; create instances at startup.
+ *	The instance scans w/ its own alarm (see Btn_CtxAlarm()), at 10 ms until the scheduler changes it,
+ *	and reads every input open until it is given a source by Btn_CtxSetInputSource().
+ *	@param[in]	numbuttons	Buttons in the bank, 1 to kBoardNumButtons; IDs 0 to numbuttons - 1.
+ *	@returns the instance, or NULL if the count is out of range or the pool is used up.
+ */
+extern ptBtnCtx Btn_CtxCreate(uint32_t numbuttons);
+#endif
+
+/** The default instance. */
+extern ptBtnCtx Btn_GetDefaultCtx(void);
+
+/** Scan alarm of an instance, for the OS scheduler; Btn_tmr_ButtonRead for the default instance.
+ *	Its reload time is the instance's scan period.
+ */
+extern tCwswSwAlarm *Btn_CtxAlarm(ptBtnCtx pctx);
+
+/** As Btn_tsk_ButtonRead(): one scan of an instance. */
+extern void Btn_CtxButtonRead(ptBtnCtx pctx, tEvQ_Event ev, uint32_t extra);
+
+/** As Btn_SetQueue(), for an instance; also sets the event of its alarm. */
+extern void Btn_CtxSetQueue(ptBtnCtx pctx, tEvQ_EventID const evid, const ptEvQ_QueueCtrlEx pEvqx);
+
+/** As Btn_SetCalibration(); the table holds one record per button of the instance. */
+extern void Btn_CtxSetCalibration(ptBtnCtx pctx, tBtnCalibration const *pcal);
+
+/** As Btn_SetCalibrationImage(); the image must be for the instance's button count. */
+extern bool Btn_CtxSetCalibrationImage(ptBtnCtx pctx, void const *pimage, size_t size);
+
+#if (BTN_CAL_MMAP)
+extern bool Btn_CtxMapCalibration(ptBtnCtx pctx, char const *path);
+#endif
+
+#if (BTN_ADAPTIVE_DEBOUNCE)
+/** As Btn_GetBounceProfile() and Btn_SetBounceProfile(); one window per button of the instance. */
+/** @{ */
+extern void Btn_CtxGetBounceProfile(ptBtnCtx pctx, uint16_t ptm[]);
+extern void Btn_CtxSetBounceProfile(ptBtnCtx pctx, uint16_t const ptm[]);
+/** @} */
+#endif
+
+#if (BTN_LATENCY_STATS)
+extern bool Btn_CtxGetLatency(ptBtnCtx pctx, uint32_t idx, tBtnLatencyStats *pstats);
+extern void Btn_CtxResetLatency(ptBtnCtx pctx);
+#endif
+
+#if (BTN_PROFILE)
+extern bool Btn_CtxDumpProfile(ptBtnCtx pctx, pfBtnTextOut pfout);
+extern void Btn_CtxResetProfile(ptBtnCtx pctx);
+#endif
+
+#if (BTN_CHORDS)
+extern bool Btn_CtxSetChords(ptBtnCtx pctx, tBtnChord const *ptbl, uint32_t count, uint32_t tmwindow);
+#endif
+
+#if (BTN_GESTURES)
+extern void Btn_CtxSetGestures(ptBtnCtx pctx, tBtnGesture const *ptbl);
+#endif
+
+#if (BTN_SCAN_GROUPS)
+/** As Btn_SetScanGroup(); periods are rounded to scans of the instance's alarm. */
+extern bool Btn_CtxSetScanGroup(ptBtnCtx pctx, uint32_t group, uint16_t tmperiod);
+#endif
+
+extern uint32_t Btn_CtxGetPostFailures(ptBtnCtx pctx);
+
+/** As Btn_GetButtonStates(); callable from any thread, while the instance is being scanned. */
+extern bool Btn_CtxGetButtonStates(ptBtnCtx pctx, tBtnStates *pstates);
+
+/** As Btn_SetInputSource(); NULL returns the default instance to the DI, and any other to reading
+ *	every input open.
+ */
+extern void Btn_CtxSetInputSource(ptBtnCtx pctx, pfBtnInputSource pfsource);
+extern void Btn_CtxSetInputTap(ptBtnCtx pctx, pfBtnInputTap pftap);
+
+#if (BTN_BATCH_EVENTS)
+extern bool Btn_CtxGetBatch(ptBtnCtx pctx, uint32_t seq, tBtnBatch *pbatch);
+#endif
 
 
 #ifdef	__cplusplus
@@ -0,0 +1,119 @@
+/** @file
+ *	@brief	Record and replay of the button inputs seen by Btn_tsk_ButtonRead().
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+#ifndef CWSW_BSP_BUTTONS_TRACE_H
+#define CWSW_BSP_BUTTONS_TRACE_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+#include "projcfg.h"
+#include "cwsw_bsp_buttons.h"	/* tBtnPortWord, kBtnNumPortWords */
+
+// ----	Module Headers --------------------------
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/** Build the input trace recorder and player. They use stdio files, so by default they are built
+ *	for the desktop boards only.
+ */
+#if !defined(BTN_TRACE)
+#if defined(__unix__) || defined(__APPLE__) || defined(_WIN32)
+#define BTN_TRACE	1
+#else
+#define BTN_TRACE	0
+#endif
+#endif
+
+/** Trace file identification. */
+enum eBtnTraceFile {
+	kBtnTraceMagic		= 0x43525442,	//!< "BTRC", read as a little-endian uint32_t.
+	kBtnTraceVersion	= 1				//!< Layout of tBtnTraceHdr and of the records.
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/** Header of a trace file.
+ *	The header is followed by run records, each a uint32_t count of scans, then the `numwords` port
+ *	words of inputs those scans all read. A run of unchanged inputs (e.g., every idle scan between
+ *	two presses) takes one record. Native byte order.
+ */
+typedef struct sBtnTraceHdr {
+	uint32_t	magic;				//!< #kBtnTraceMagic.
+	uint16_t	version;			//!< #kBtnTraceVersion.
+	uint16_t	numbuttons;			//!< kBoardNumButtons of the recording build.
+	uint16_t	scantm;				//!< Scan period (ms) of the recording.
+	uint16_t	numwords;			//!< Port words per record.
+} tBtnTraceHdr;
+
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+#if (BTN_TRACE)
+/** Start recording the inputs of every scan of the default instance, whichever source they come
+ *	from.
+ *	@param[in]	path	Trace file to create (or overwrite).
+ *	@returns false if the file can't be created, or a recording is already in progress.
+ */
+extern bool		Btn_TraceRecord(char const *path);
+
+/** Finish the recording in progress, and close its file.
+ *	@returns false if any part of the trace could not be written.
+ */
+extern bool		Btn_TraceRecordStop(void);
+
+/** Load a trace for replay, and make it the source of button inputs.
+ *	The trace must have been recorded for the same button count and scan period as this build.
+ *	@param[in]	path	Trace file.
+ *	@returns false if the file can't be read, or doesn't match this build.
+ */
+extern bool		Btn_TraceOpen(char const *path);
+
+/** Run the next scans of the loaded trace through Btn_tsk_ButtonRead(), as fast as they will go.
+ *	Events are posted to the button queue as usual; drain it between calls.
+ *	@param[in]	ev			Event handed to Btn_tsk_ButtonRead().
+ *	@param[in]	maxscans	Most scans to run in this call.
+ *	@returns the number of scans run; 0 once the trace is exhausted.
+ */
+extern uint32_t	Btn_TraceReplay(tEvQ_Event ev, uint32_t maxscans);
+
+/** Release the loaded trace, and return the button inputs to the board's DI. */
+extern void		Btn_TraceClose(void);
+#endif
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_BSP_BUTTONS_TRACE_H */
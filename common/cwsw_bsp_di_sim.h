@@ -0,0 +1,95 @@
+/** @file
+ *	@brief	Edge timeline for the simulated digital inputs of the desktop boards.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+#ifndef CWSW_BSP_DI_SIM_H
+#define CWSW_BSP_DI_SIM_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+#include "projcfg.h"
+#include "cwsw_lib.h"			/* tCwswClockTics */
+#include "cwsw_board.h"			/* kBoardNumButtons */
+
+// ----	Module Headers --------------------------
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/** Edges each button's timeline can hold between scans. A simulated press or release queues one
+ *	edge per transition of its bounce profile (3 at present), so the default holds 21 presses and
+ *	releases that arrive within one scan period.
+ */
+#if !defined(DI_SIM_EDGE_DEPTH)
+#define DI_SIM_EDGE_DEPTH	64
+#endif
+
+/** How long (ms) a simulated button is held, once its bounce settles, when it is operated again at
+ *	the same instant; e.g., the press and release of a GTK "clicked" signal, which carry one event
+ *	time. Long enough for the default debounce windows to see the press.
+ */
+#if !defined(DI_SIM_CLICK_HOLD)
+#define DI_SIM_CLICK_HOLD	120
+#endif
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+/** Queue one simulated press or release, including its contact bounce.
+ *	Queued edges of the same button at or after `when` (the tail of an earlier bounce) are discarded,
+ *	so the timeline stays in time order. The exception is an operation at (or before) the instant of
+ *	the button's previous one, as when a click's press and release arrive together: it is queued to
+ *	start #DI_SIM_CLICK_HOLD ms after the previous one has settled, so that both are seen.
+ *	@param[in]	idx		Button ID.
+ *	@param[in]	level	New level of the button; true for pressed.
+ *	@param[in]	when	Clock time (ms) at which the button was operated.
+ *	@returns false if the button ID is invalid or its timeline is full; nothing is queued, and nothing
+ *	already queued is discarded.
+ */
+extern bool		di_sim_add_transition(uint32_t idx, bool level, tCwswClockTics when);
+
+/** Level of one simulated input at the given instant.
+ *	Consumes every queued edge at or before `now`. Calls for one button must use non-decreasing
+ *	times.
+ *	@param[in]	idx		Button ID.
+ *	@param[in]	now		Clock time (ms) of the scan.
+ *	@returns true if the input is active (button pressed).
+ */
+extern bool		di_sim_level_at(uint32_t idx, tCwswClockTics now);
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_BSP_DI_SIM_H */
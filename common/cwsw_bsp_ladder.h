@@ -0,0 +1,125 @@
+/** @file
+ *	@brief	Resistor-ladder keypads: several buttons on one analog input, each pulling it to its own
+ *	level. Decoded into button inputs for the button SME.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+#ifndef CWSW_BSP_LADDER_H
+#define CWSW_BSP_LADDER_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+#include "projcfg.h"
+#include "cwsw_board.h"			/* BOARD_LADDER */
+
+// ----	Module Headers --------------------------
+#include "cwsw_bsp_analog.h"	/* the ladders are read through the analog inputs */
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/** The board has resistor-ladder keypads on some of its analog inputs, and its
+ *	di_read_next_button_input_bit() reads their buttons through Ladder_ButtonInput().
+ */
+#if !defined(BOARD_LADDER)
+#define BOARD_LADDER		0
+#endif
+
+#if (BOARD_LADDER) && !(BOARD_ANALOG)
+#error "Resistor-ladder keypads (BOARD_LADDER) require analog inputs (BOARD_ANALOG)"
+#endif
+
+/** Most ladders decoded at once. */
+#if !defined(LADDER_MAX_LADDERS)
+#define LADDER_MAX_LADDERS	4
+#endif
+
+/** Most bands on one ladder: one per button, plus the idle level. */
+#if !defined(LADDER_MAX_BANDS)
+#define LADDER_MAX_BANDS	16
+#endif
+
+/** Button of a band in which no button is pressed (the idle level, or a gap between two buttons). */
+enum { kLadderNoButton = UINT16_MAX };
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/** One band of a ladder: the readings from `lower` up to the `lower` of the next band. */
+typedef struct sLadderBand {
+	uint16_t	lower;			//!< Lowest reading in the band, in ADC counts; the first band's is 0.
+	uint16_t	button;			//!< Button ID pressed in the band; #kLadderNoButton for none.
+} tLadderBand;
+
+/** One ladder: the analog channel it is wired to, and the bands its readings fall in. */
+typedef struct sLadder {
+	uint32_t			ch;			//!< Analog channel, one of the board's `eBoardAnalogs` values.
+	tLadderBand const	*pbands;	//!< Bands, in ascending order of `lower`.
+	uint16_t			numbands;	//!< Bands in the table; 2 to #LADDER_MAX_BANDS.
+	uint16_t			hysteresis;	//!< Counts a reading must go past the edge of the current band to leave it.
+} tLadder;
+
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+#if (BOARD_LADDER)
+/** Register the board's ladders. Register them before the acquisition task runs; until the first
+ *	frames are decoded, no ladder button reads pressed.
+ *	@param[in]	ptbl	Ladder table; used in place, so it must remain valid until replaced. NULL (w/ a
+ *						count of 0) stops decoding.
+ *	@param[in]	count	Number of ladders; at most #LADDER_MAX_LADDERS.
+ *	@returns false if the table is too long, or a ladder's channel is out of range, or its bands are
+ *	too few or too many, start above 0, are out of order, or are no wider than twice its hysteresis;
+ *	no ladder is decoded until a valid table is registered.
+ */
+extern bool Ladder_SetTable(tLadder const *ptbl, uint32_t count);
+
+/** Classify every sample of every ladder in a block of raw frames, and keep the button of the
+ *	latest. A reading stays in its band until it passes one of the band's edges by the ladder's
+ *	hysteresis; it is then placed in its new band by a binary search of the table. Register it w/
+ *	Ain_SetBlockTap().
+ */
+extern void Ladder_Decode(uint16_t const *pframes, uint32_t nframes);
+
+/** Input of one button, as decoded from the ladders: the button of some ladder's current band.
+ *	Wait-free, and callable from any thread; the board's di_read_next_button_input_bit() returns it
+ *	for ladder buttons, so that the button SME debounces them as it does its discrete inputs.
+ *	@param[in]	idx	Button ID.
+ *	@returns true if the button is pressed.
+ */
+extern bool Ladder_ButtonInput(uint32_t idx);
+#endif
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_BSP_LADDER_H */
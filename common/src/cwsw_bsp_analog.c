@@ -0,0 +1,289 @@
+/** @file
+ *	@brief	Analog input acquisition common to all boards w/ analog inputs.
+ *
+ *	The board samples every channel at its own rate (a DMA-driven ADC scan on real hardware; a
+ *	generator or UI control on the desktop boards), and hands over the frames it has collected in
+ *	blocks. Each block is filtered channel-parallel: a moving average, then a first-order IIR
+ *	low-pass, both in integer arithmetic, over 8 channels per instruction w/ AVX2. The filtered signal
+ *	is decimated, and its latest value published for readers on any thread.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdbool.h>
+#include <string.h>					// memcpy
+#if defined(__AVX2__)
+#include <immintrin.h>				// 8 channels per operation
+#endif
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>				// published values
+#define AIN_ATOMIC	1
+#else
+#define AIN_ATOMIC	0
+#endif
+
+// ----	Project Headers -------------------------
+#include "cwsw_board.h"				// this module builds on top of the BSP
+
+// ----	Module Headers --------------------------
+#include "cwsw_bsp_analog.h"		// public API for this module
+
+#if (BOARD_ANALOG)
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum eAinSizes {
+	/// Channels filtered per operation; the filter state is padded to a whole number of them.
+	kAinLanes		= 8,
+	kAinPadded		= ((kBoardNumAnalogs + kAinLanes - 1) / kAinLanes) * kAinLanes,
+
+	/// log2(#AIN_MA_TAPS).
+	kAinMaShift		= (AIN_MA_TAPS >= 2) + (AIN_MA_TAPS >= 4) + (AIN_MA_TAPS >= 8) + (AIN_MA_TAPS >= 16) +
+					  (AIN_MA_TAPS >= 32) + (AIN_MA_TAPS >= 64) + (AIN_MA_TAPS >= 128) + (AIN_MA_TAPS >= 256) +
+					  (AIN_MA_TAPS >= 512) + (AIN_MA_TAPS >= 1024) + (AIN_MA_TAPS >= 2048) + (AIN_MA_TAPS >= 4096) +
+					  (AIN_MA_TAPS >= 8192) + (AIN_MA_TAPS >= 16384) + (AIN_MA_TAPS >= 32768)
+};
+
+/** Sequence number of the published values; see tBtnStatesSeq in cwsw_bsp_buttons.c. */
+#if (AIN_ATOMIC)
+typedef atomic_uint_least32_t	tAinSeq;
+#define AIN_SEQ_LOAD(seq, order)		atomic_load_explicit(&(seq), memory_order_##order)
+#define AIN_SEQ_STORE(seq, v, order)	atomic_store_explicit(&(seq), (v), memory_order_##order)
+#define AIN_SEQ_FENCE(order)			atomic_thread_fence(memory_order_##order)
+#else
+typedef volatile uint32_t		tAinSeq;
+#define AIN_SEQ_LOAD(seq, order)		(seq)
+#define AIN_SEQ_STORE(seq, v, order)	((seq) = (v))
+#define AIN_SEQ_FENCE(order)			((void)0)
+#endif
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/// The moving average's delay line is indexed w/ a mask.
+typedef char tAinMaTapsArePowerOf2[((AIN_MA_TAPS >= 1) && (AIN_MA_TAPS <= 32768) && ((1L << kAinMaShift) == AIN_MA_TAPS)) ? 1 : -1];
+
+/// The IIR accumulator, a 16-bit sample scaled by 2^AIN_IIR_SHIFT, fits 32 bits.
+typedef char tAinIirShiftFits[((AIN_IIR_SHIFT >= 0) && (AIN_IIR_SHIFT <= 15)) ? 1 : -1];
+
+typedef char tAinBlockAndDecimationArePositive[((AIN_BLOCK_FRAMES >= 1) && (AIN_DECIMATE >= 1)) ? 1 : -1];
+
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+tCwswSwAlarm	Ain_tmr_Acquire = {
+	/* .tm			= */tmr10ms,
+	/* .reloadtm	= */tmr10ms,
+	/* .pEvQX		= */NULL,
+	/* .evid		= */0,
+	/* .tmrstate	= */kTmrState_Enabled
+};
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+/** One block of frames, as the board hands them over: kBoardNumAnalogs samples per frame. The slack
+ *	lets the last lanes of the last frame be loaded whole.
+ */
+static uint16_t block[(AIN_BLOCK_FRAMES * kBoardNumAnalogs) + kAinLanes];
+
+/** Filter state of every channel (and of the padding lanes, which is never published). */
+static struct sAinFilter {
+	uint32_t	hist[AIN_MA_TAPS][kAinPadded];		//!< Moving average's delay line: the last AIN_MA_TAPS samples.
+	uint32_t	masum[kAinPadded];					//!< Sum of the delay line.
+	uint32_t	iir[kAinPadded];					//!< IIR output, scaled by 2^AIN_IIR_SHIFT.
+	uint32_t	out[kAinPadded];					//!< Output at the latest decimation point.
+	uint32_t	pos;								//!< Delay-line slot of the next frame.
+	uint32_t	phase;								//!< Frames since the latest decimation point.
+} flt;
+
+/** Published values. `seq` is even between publications, and odd during one; publication seq / 2 is
+ *	in `copy[(seq / 2) & 1]`, and the task writes the other copy.
+ */
+static struct sAinPub {
+	tAinSeq		seq;
+	uint16_t	copy[2][kBoardNumAnalogs];
+} pub;
+
+static pfAinBlockTap	pfBlockTap = NULL;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/** Run a block of frames through the filters, and note the output at the last decimation point in
+ *	it, if any.
+ *	@param[in]	nframes	Frames in `block`.
+ *	@returns true if the block holds a decimation point.
+ */
+static bool
+FilterBlock(uint32_t nframes)
+{
+	// the last frame of the block that completes a decimation period; nframes if none does.
+	uint32_t todecimate = (AIN_DECIMATE - 1) - flt.phase;
+	uint32_t lastout = (todecimate < nframes) ? todecimate + (((nframes - 1 - todecimate) / AIN_DECIMATE) * AIN_DECIMATE) : nframes;
+	uint32_t c = 0;
+
+#if defined(__AVX2__)
+	for(; c < kAinPadded; c += kAinLanes)
+	{
+		__m256i sum	= _mm256_loadu_si256((__m256i const *)&flt.masum[c]);
+		__m256i iir	= _mm256_loadu_si256((__m256i const *)&flt.iir[c]);
+		uint16_t const *pin = &block[c];
+		uint32_t pos = flt.pos;
+		uint32_t f;
+
+		for(f = 0; f < nframes; ++f, pin += kBoardNumAnalogs)
+		{
+			__m256i x	= _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i const *)pin));
+			__m256i old	= _mm256_loadu_si256((__m256i const *)&flt.hist[pos][c]);
+			_mm256_storeu_si256((__m256i *)&flt.hist[pos][c], x);
+			pos = (pos + 1) & (AIN_MA_TAPS - 1);
+
+			sum = _mm256_add_epi32(_mm256_sub_epi32(sum, old), x);
+			iir = _mm256_add_epi32(_mm256_sub_epi32(iir, _mm256_srli_epi32(iir, AIN_IIR_SHIFT)), _mm256_srli_epi32(sum, kAinMaShift));
+			if(f == lastout)	{ _mm256_storeu_si256((__m256i *)&flt.out[c], _mm256_srli_epi32(iir, AIN_IIR_SHIFT)); }
+		}
+		_mm256_storeu_si256((__m256i *)&flt.masum[c], sum);
+		_mm256_storeu_si256((__m256i *)&flt.iir[c], iir);
+	}
+#endif
+	for(; c < kBoardNumAnalogs; ++c)
+	{
+		uint32_t sum = flt.masum[c], iir = flt.iir[c];
+		uint16_t const *pin = &block[c];
+		uint32_t pos = flt.pos;
+		uint32_t f;
+
+		for(f = 0; f < nframes; ++f, pin += kBoardNumAnalogs)
+		{
+			uint32_t x = *pin;
+			sum += x - flt.hist[pos][c];
+			flt.hist[pos][c] = x;
+			pos = (pos + 1) & (AIN_MA_TAPS - 1);
+
+			iir += (sum >> kAinMaShift) - (iir >> AIN_IIR_SHIFT);
+			if(f == lastout)	{ flt.out[c] = iir >> AIN_IIR_SHIFT; }
+		}
+		flt.masum[c] = sum;
+		flt.iir[c] = iir;
+	}
+
+	flt.pos = (flt.pos + nframes) & (AIN_MA_TAPS - 1);
+	flt.phase = (flt.phase + nframes) % AIN_DECIMATE;
+	return lastout < nframes;
+}
+
+/** Publish the output at the latest decimation point. */
+static void
+Publish(void)
+{
+	uint32_t seq = AIN_SEQ_LOAD(pub.seq, relaxed);
+	uint32_t next = seq + 2;
+	uint16_t *pcopy = pub.copy[((seq / 2) + 1) & 1];
+	uint32_t c;
+
+	// 0 means nothing published; on wrapping, skip on to the next count that names the same copy.
+	if(!next)	{ next = 4; }
+
+	AIN_SEQ_STORE(pub.seq, seq + 1, relaxed);
+	AIN_SEQ_FENCE(release);
+	for(c = 0; c < kBoardNumAnalogs; ++c)
+	{
+		pcopy[c] = (uint16_t)flt.out[c];
+	}
+	AIN_SEQ_STORE(pub.seq, next, release);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+void
+Ain_SetQueue(tEvQ_EventID const evId, const ptEvQ_QueueCtrlEx pEvqx)
+{
+	Ain_tmr_Acquire.pEvQX = pEvqx;
+	Ain_tmr_Acquire.evid = evId;
+}
+
+void
+Ain_SetBlockTap(pfAinBlockTap pftap)
+{
+	pfBlockTap = pftap;
+}
+
+void
+Ain_tsk_Acquire(tEvQ_Event ev, uint32_t extra)
+{
+	bool decimated = false;
+	uint32_t nframes;
+	UNUSED(ev);
+	UNUSED(extra);
+
+	do {
+		nframes = ai_read_samples(block, AIN_BLOCK_FRAMES);
+		if(nframes > AIN_BLOCK_FRAMES)	{ nframes = AIN_BLOCK_FRAMES; }
+		if(nframes && pfBlockTap)			{ pfBlockTap(block, nframes); }
+		if(nframes && FilterBlock(nframes))	{ decimated = true; }
+	} while(nframes == AIN_BLOCK_FRAMES);
+
+	if(decimated)	{ Publish(); }
+}
+
+uint32_t
+Ain_GetAll(uint16_t values[kBoardNumAnalogs])
+{
+	uint32_t seq, now;
+
+	if(!values)	{ return 0; }
+	do {
+		seq = AIN_SEQ_LOAD(pub.seq, acquire) & ~(uint32_t)1;
+		if(!seq)	{ return 0; }
+		// a plain copy, which races w/ a publication that laps this reader; the race is the sequence
+		//	lock's own, and a torn copy is never returned (see Btn_CtxGetButtonStates()).
+		(void)memcpy(values, pub.copy[(seq / 2) & 1], sizeof(pub.copy[0]));
+
+		// good unless a publication has since started to overwrite this copy, 2 on.
+		AIN_SEQ_FENCE(acquire);
+		now = AIN_SEQ_LOAD(pub.seq, relaxed);
+	} while((uint32_t)(now - seq) > 2);
+	return seq / 2;
+}
+
+uint16_t
+Ain_Get(uint32_t ch)
+{
+	uint32_t seq, now;
+	uint16_t value;
+
+	if(ch >= kBoardNumAnalogs)	{ return 0; }
+	do {
+		seq = AIN_SEQ_LOAD(pub.seq, acquire) & ~(uint32_t)1;
+		if(!seq)	{ return 0; }
+		value = pub.copy[(seq / 2) & 1][ch];
+		AIN_SEQ_FENCE(acquire);
+		now = AIN_SEQ_LOAD(pub.seq, relaxed);
+	} while((uint32_t)(now - seq) > 2);
+	return value;
+}
+
+#endif	/* BOARD_ANALOG */
@@ -14,6 +14,21 @@
 
 // ----	System Headers --------------------------
 #include <stdbool.h>
+#include <string.h>					// memset
+#if defined(__unix__) || defined(__APPLE__)	// Btn_MapCalibration()
+#include <fcntl.h>					// open
+#include <sys/mman.h>				// mmap
+#include <sys/stat.h>				// fstat
+#include <unistd.h>					// close
+#include <pthread.h>				// scan workers
+#include <stdatomic.h>				// shard ranges
+#endif
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>				// published button states
+#define BTN_STATES_ATOMIC	1
+#else
+#define BTN_STATES_ATOMIC	0
+#endif
 
 // ----	Project Headers -------------------------
 #include "cwsw_board.h"				// this module builds on top of the BSP
@@ -28,33 +43,635 @@
 // ============================================================================
 
 /// "Reason3" reasons for exiting a state.
-enum { kReasonNone, kReasonTwitchNoted, kReasonDebounced, kReasonTimeout, kReasonButtonUnstuck };
+enum { kReasonNone, kReasonTwitchNoted, kReasonDebounced, kReasonTimeout, kReasonButtonUnstuck, kNumReasons };
 
-/// @todo Move this to a board-specific calibration.
+/// Compiled-in calibration, applied to every button until a table or image is supplied.
 enum eButtonCalibrationValues {
 	/// Stuck button timeout value.
 	kButtonStuckTimeoutValue = tmr1000ms * 30,
 
-	/// Debounce time for board-level button-handling state machine.
-	/* this timeout is just "comfortably" shy of enough time to read the full defined input
-	 *	value of "noisy" input bits. the expected behavior then, is that this should transition
-	 *	back to the released state, and immediately transition back here because the input stream
-	 *	will have a few more "1" bits left in it. this 2nd invocation will result in a "solid"
-	 *	debounced "press" reading.
-	 * we know that this will take more overall time but for demonstration purposes will have
-	 *	the same end result. timing: 1 cycle for our exit action, 1 cycle for "released"'s
-	 *	entry action, 1 cycle for "released" to read a "1" bit, 1 cycle for "released"'s exit
-	 *	action, 1 cycle for our entry action, and then we can begin accumulating debouncing bits.
+	/// Debounce window, press and release: 8 consecutive samples at the 10 ms scan rate.
+	kTmButtonDebounceWindow = tmr10ms * 8,
+
+	/// Give-up time for a debounce that never settles.
+	/* this is not a calibration of the button, it's a limit on how long the SM will chase a noisy
+	 *	input. when it expires, the SM returns to the state it was debouncing away from, and if the
+	 *	input is still active, comes straight back here for another try.
 	 */
-	// 750 ms is long enough to read 64 bits of input stream, w/ ~100+ ms margin
 	kTmButtonDebounceTime = tmr500ms + tmr100ms
 };
 
+#if (BTN_ENGINE == BTN_ENGINE_SME)
+/** States of the button SM.
+ *	Each button's current state is kept as an index into tblStates[].
+ */
+#define BTN_STATES(X)		\
+	X(Start)				\
+	X(ButtonReleased)		\
+	X(DebouncePress)		\
+	X(ButtonPressed)		\
+	X(DebounceRelease)		\
+	X(ButtonStuck)
+
+#define BTN_STATE_ID(name)	kBtnSt_##name,
+enum eBtnStates { BTN_STATES(BTN_STATE_ID) kBtnNumStates };
+
+/** "Reason1" events that can end a state, compacted to an index for the transition lookup.
+ *	@{
+ */
+enum eBtnExitEvents { kBtnExEv_Task, kBtnExEv_Pressed, kBtnExEv_Released, kBtnNumExitEvents };
+#define BTN_EV_Task			evButton_Task
+#define BTN_EV_Pressed		evBntPressed
+#define BTN_EV_Released		evBtnReleased
+/** @} */
+
+/** Every exit each state can take, as (state, Reason1, Reason3).
+ *	Checked at compile time against the transition table (BTN_TRANSITIONS): an exit with no
+ *	transition, a transition no state can take, or two transitions for the same exit, all fail the
+ *	build.
+ */
+#define BTN_STATE_EXITS(X)								\
+	X(Start,			Task,		None)				\
+	X(ButtonReleased,	Task,		TwitchNoted)		\
+	X(DebouncePress,	Pressed,	Debounced)			\
+	X(DebouncePress,	Released,	Debounced)			\
+	X(DebouncePress,	Task,		Timeout)			\
+	X(ButtonPressed,	Task,		TwitchNoted)		\
+	X(ButtonPressed,	Task,		Timeout)			\
+	X(DebounceRelease,	Released,	Debounced)			\
+	X(DebounceRelease,	Pressed,	Debounced)			\
+	X(DebounceRelease,	Task,		Timeout)			\
+	X(ButtonStuck,		Task,		ButtonUnstuck)
+
+/* the button reads use the following state machine:
+ * start -> released -> debounce-press -> pressed -> debounce-release
+ * 				^				|			|               |
+ * 				+-------- timeout (stuck)  -/               |
+ * 				\-------------------------------------------/ (once debounced; a debounce timeout returns to pressed)
+ *
+ *	~these transitions are in the same order as listed in the design document.~ (not anymore)
+ *
+ *	the table is an X-macro so that the compile-time checks, the rows, and the dense lookup index are
+ *	all generated from this one list.
+ */
+#define BTN_TRANSITIONS(X)																			\
+	/* current			Reason1		Reason3			Next State			Transition Func			*/	\
+	X( Start,			Task,		None,			ButtonReleased,		NullTransition		)	/* normal termination */ \
+																									\
+	X( ButtonReleased,	Task,		TwitchNoted,	DebouncePress,		NullTransition		)	/* normal termination: non-0 bit seen @ button */ \
+																									\
+	X( DebouncePress,	Pressed,	Debounced,		ButtonPressed,		NotifyBtnStateChg	)	/* normal termination (input steady "pressed" for the press window) */ \
+	X( DebouncePress,	Released,	Debounced,		ButtonReleased,		NullTransition		)	/* debounced input is 0. no need to post event, since debounced state hasn't changed. */ \
+	X( DebouncePress,	Task,		Timeout,		ButtonReleased,		NullTransition		)	/* debounce timeout */ \
+																									\
+	X( ButtonPressed,	Task,		TwitchNoted,	DebounceRelease,	NullTransition		)	\
+	X( ButtonPressed,	Task,		Timeout,		ButtonStuck,		NotifyBtnStateChg	)	/* button stuck, go directly back to "stuck" state */ \
+																									\
+	X( DebounceRelease,	Released,	Debounced,		ButtonReleased,		NotifyBtnStateChg	)	\
+	X( DebounceRelease,	Pressed,	Debounced,		ButtonPressed,		NullTransition		)	\
+	/* debounce timeout. the debounced state is still "pressed"; if the input has really opened, */	\
+	/*	"pressed" sees it on its next read and tries again. */										\
+	X( DebounceRelease,	Task,		Timeout,		ButtonPressed,		NullTransition		)	\
+																									\
+	/* in the interests of simplicity (MVP), we'll jump directly back to the Released state. */		\
+	/*	we could insert another instance of the debouncer, but except for transition time, the end effect will be the same. */ \
+	X( ButtonStuck,		Task,		ButtonUnstuck,	ButtonReleased,		NotifyBtnStateChg	)
+
+/// Transition IDs. A repeated (state, Reason1, Reason3) key is a duplicate enumerator.
+#define BTN_TRANSITION_ID(cur, r1, r3, next, fn)	kBtnTr_##cur##_##r1##_##r3,
+enum eBtnTransitions { BTN_TRANSITIONS(BTN_TRANSITION_ID) kBtnNumTransitions };
+
+/// Each state exit must name an existing transition ...
+#define BTN_STATE_EXIT_ID(cur, r1, r3)				kBtnExit_##cur##_##r1##_##r3 = kBtnTr_##cur##_##r1##_##r3,
+enum eBtnStateExits { BTN_STATE_EXITS(BTN_STATE_EXIT_ID) kBtnExit_Unused };
+
+/// ... and there must be no transition beyond those.
+#define BTN_STATE_EXIT_COUNT(cur, r1, r3)			+ 1
+enum { kBtnNumStateExits = 0 BTN_STATE_EXITS(BTN_STATE_EXIT_COUNT) };
+typedef char tBtnTransitionTableIsComplete[((int)kBtnNumStateExits == (int)kBtnNumTransitions) ? 1 : -1];
+#endif
+
+#if (BTN_ADAPTIVE_DEBOUNCE)
+/// Tuning of adaptive debounce.
+enum eBtnAdaptation {
+	/// Scans kept in hand beyond the longest steady stretch seen within a bounce.
+	kBtnAdaptMargin = 1,
+
+	/// Consecutive debounces that must all fit a narrower window before the window narrows by one
+	///	scan. Widening is immediate.
+	kBtnAdaptNarrowAfter = 16
+};
+#endif
+
+#if (BTN_LATENCY_STATS)
+/** Layout of the latency histograms, in scans.
+ *	Latencies below 2 * #kBtnLatSubBuckets scans have a bucket each; above that, each power-of-two
+ *	range is split into #kBtnLatSubBuckets equal buckets, so a bucket is never wider than 1/8 of its
+ *	value.
+ */
+enum eBtnLatencyHistogram {
+	kBtnLatSubBits		= 3,
+	kBtnLatSubBuckets	= 1 << kBtnLatSubBits,
+	kBtnLatMaxExp		= 16,		//!< Latencies of 2^16 scans or more share the last bucket.
+	kBtnLatBuckets		= (kBtnLatMaxExp - kBtnLatSubBits + 1) * kBtnLatSubBuckets
+};
+#endif
+
+#if (BTN_GESTURES)
+/// Per-button gesture flags.
+enum eBtnGestureFlags {
+	kGstLongPending		= 0x01,		//!< Held; long-press not yet posted.
+	kGstRepeatPending	= 0x02,		//!< Held; auto-repeat running.
+	kGstClickOpen		= 0x04,		//!< Released after a click; a press now may be a double-click.
+	kGstNoClick			= 0x08		//!< This press doesn't count as a click (it was a double-click, a long-press or a repeat).
+};
+#endif
+
+#if (BTN_ENGINE == BTN_ENGINE_SME) && (BTN_COMPACT)
+/** Longest state timeout, in scans; a 16-bit deadline is then never more than half its range away. */
+enum { kBtnTimerMaxScans = INT16_MAX };
+#endif
+
+#if (BTN_ENGINE == BTN_ENGINE_SME) && !(BTN_COMPACT)
+/** Geometry of the state-timer wheel.
+ *	Level 0 has a slot per scan for the next 256 scans; each further level has 64 slots, each as wide
+ *	as all of the level below. A timer further out than the wheel spans (2^26 scans; over a week at
+ *	10 ms) is parked in the last level until it comes within range.
+ */
+enum eBtnTimerWheel {
+	kBtnWheelL0Bits		= 8,
+	kBtnWheelLnBits		= 6,
+	kBtnWheelUpper		= 3,									//!< Levels above level 0.
+	kBtnWheelL0Slots	= 1 << kBtnWheelL0Bits,
+	kBtnWheelLnSlots	= 1 << kBtnWheelLnBits,
+	kBtnWheelSlots		= kBtnWheelL0Slots + (kBtnWheelUpper * kBtnWheelLnSlots),
+	kBtnWheelSpanBits	= kBtnWheelL0Bits + (kBtnWheelUpper * kBtnWheelLnBits)
+};
+#endif
+
+#if (BTN_ENGINE == BTN_ENGINE_SME)
+
+/** Scan shards. A threaded scan splits the port words into shards of BTN_SHARD_WORDS; otherwise the
+ *	whole bank is one shard.
+ */
+enum eBtnShards {
+	kBtnCacheLine		= 64,
+#if (BTN_SCAN_THREADS)
+	kBtnShardWords		= BTN_SHARD_WORDS,
+#else
+	kBtnShardWords		= kBtnNumPortWords,
+#endif
+	kBtnShardButtons	= kBtnShardWords * kBtnBitsPerWord,
+	kBtnNumShards		= (kBtnNumPortWords + kBtnShardWords - 1) / kBtnShardWords
+};
+
+/// Starts each per-button or per-word array that a shard's worker writes on a cache line of its own.
+///	Shards are whole cache lines of each such array, so no two shards then share a line.
+#if (BTN_SCAN_THREADS)
+#define BTN_SHARD_ALIGNED	__attribute__((aligned(kBtnCacheLine)))
+#else
+#define BTN_SHARD_ALIGNED
+#endif
+
+#if (BTN_SPECIALIZE)
+/// The specialized scan, unrolled over the bits of a port word, from the top down.
+#define BTN_SCAN_BITS8(X, b)	X((b) + 7) X((b) + 6) X((b) + 5) X((b) + 4) X((b) + 3) X((b) + 2) X((b) + 1) X((b) + 0)
+#define BTN_SCAN_BITS(X)		BTN_SCAN_BITS8(X, 56) BTN_SCAN_BITS8(X, 48) BTN_SCAN_BITS8(X, 40) BTN_SCAN_BITS8(X, 32) \
+								BTN_SCAN_BITS8(X, 24) BTN_SCAN_BITS8(X, 16) BTN_SCAN_BITS8(X, 8) BTN_SCAN_BITS8(X, 0)
+#endif
+#endif
+
+#if (BTN_ENGINE == BTN_ENGINE_VERTICAL_COUNTER)
+/** The port words the vertical-counter engine steps at once: a 256-bit vector where GCC's vector
+ *	extension can put one in a register, else a single word.
+ */
+#if defined(__AVX2__) && defined(__GNUC__)
+typedef tBtnPortWord tBtnVcLanes __attribute__((vector_size(32)));
+#else
+typedef tBtnPortWord tBtnVcLanes;
+#endif
+
+/// Sizing for the vertical-counter engine.
+enum eBtnVertCtrSizes {
+	/// Planes in the debounce run counter; enough to count past #kBtnMaxDebounceSamples.
+	kBtnVcCountPlanes = 6,
+
+	/// Planes in the state timer. 16 planes hold the stuck timeout at scan rates down to 1 ms.
+	kBtnVcTimerPlanes = 16,
+
+	/// Port words per step; steps in the bank; and its port words, rounded up to whole steps.
+	kBtnVcLaneWords	= sizeof(tBtnVcLanes) / sizeof(tBtnPortWord),
+	kBtnVcSteps		= (kBtnNumPortWords + kBtnVcLaneWords - 1) / kBtnVcLaneWords,
+	kBtnVcWords		= kBtnVcSteps * kBtnVcLaneWords
+};
+
+/// SM states of the vertical-counter engine; a button in none of them is in "start".
+enum eBtnVcStates {
+	kBtnVcReleased,
+	kBtnVcDebouncePress,
+	kBtnVcPressed,
+	kBtnVcDebounceRelease,
+	kBtnVcStuck,
+	kBtnVcNumStates
+};
+
+/// Events the vertical-counter engine posts, one edge word each.
+enum eBtnVcEdges {
+	kBtnVcEdgePressed,
+	kBtnVcEdgeReleased,
+	kBtnVcEdgeStuck,
+	kBtnVcEdgeUnstuck,
+	kBtnVcNumEdges
+};
+#endif
+
+/// Port words of the inputs; the vertical-counter engine reads them in whole steps.
+#if (BTN_ENGINE == BTN_ENGINE_VERTICAL_COUNTER)
+enum { kBtnInputWords = kBtnVcWords };
+#else
+enum { kBtnInputWords = kBtnNumPortWords };
+#endif
+
+/// The vertical counters' edge words go straight into the scan's batch, w/o a per-event path; the
+///	chord and gesture recognizers need to see each event.
+#define BTN_VC_BATCH_DIRECT	((BTN_ENGINE == BTN_ENGINE_VERTICAL_COUNTER) && (BTN_BATCH_EVENTS) && !(BTN_CHORDS) && !(BTN_GESTURES))
+
+#if (BTN_BATCH_EVENTS)
+/// Batch slots: the #BTN_BATCH_DEPTH retained, and the one being collected.
+enum { kBtnBatchSlots = BTN_BATCH_DEPTH + 1 };
+#endif
 
 // ============================================================================
 // ----	Type Definitions ------------------------------------------------------
 // ============================================================================
 
+#if (BTN_ENGINE == BTN_ENGINE_SME)
+/** Per-button fields of the SME engine; a byte each w/ #BTN_COMPACT.
+ *	@{
+ */
+#if (BTN_COMPACT)
+typedef uint8_t				tBtnPhase;		//!< tStateReturnCodes.
+typedef uint8_t				tBtnReason1;	//!< Exit event: evButton_Task, evBntPressed or evBtnReleased.
+typedef uint8_t				tBtnReason3;	//!< kReason...
+typedef uint8_t				tBtnHistory;	//!< Debounce shift register; holds kBtnMaxDebounceSamples samples.
+#else
+typedef tStateReturnCodes	tBtnPhase;
+typedef tEvQ_EventID		tBtnReason1;
+typedef uint32_t			tBtnReason3;
+typedef uint32_t			tBtnHistory;
+#endif
+/** @} */
+#endif
+
+/** Sequence number of the published button states. W/o C11 atomics, readers must share a core w/ the
+ *	scan (e.g., an ISR, or another task of a single-core scheduler), which a volatile counter serves.
+ */
+#if (BTN_STATES_ATOMIC)
+typedef atomic_uint_least32_t	tBtnStatesSeq;
+#define BTN_SEQ_LOAD(seq, order)		atomic_load_explicit(&(seq), memory_order_##order)
+#define BTN_SEQ_STORE(seq, v, order)	atomic_store_explicit(&(seq), (v), memory_order_##order)
+#define BTN_SEQ_FENCE(order)			atomic_thread_fence(memory_order_##order)
+#else
+typedef volatile uint32_t		tBtnStatesSeq;
+#define BTN_SEQ_LOAD(seq, order)		(seq)
+#define BTN_SEQ_STORE(seq, v, order)	((seq) = (v))
+#define BTN_SEQ_FENCE(order)			((void)0)
+#endif
+
+/** One button engine instance: everything a bank of buttons needs from one scan to the next.
+ *	Nothing the scan writes lives outside the instance, so instances may be scanned concurrently, each
+ *	by one thread at a time.
+ */
+struct sBtnCtx {
+	tCwswSwAlarm		*ptmr;						//!< Scan alarm: Btn_tmr_ButtonRead for the default instance, else `tmr`.
+	uint32_t			numbuttons;					//!< Buttons in the bank; those above are never scanned.
+	tCwswSwAlarm		tmr;						//!< Scan alarm of an instance from Btn_CtxCreate().
+
+	ptEvQ_QueueCtrlEx	pBtnEvqx;					//!< Queue for button events.
+
+	/** Button inputs, sampled once at the start of each scan. */
+	tBtnPortWord		inputs[kBtnInputWords];
+
+	/** Replacement for the board's DI as the source of button inputs, or NULL. */
+	pfBtnInputSource	pfInputSource;
+
+	/** Observer of each scan's inputs, or NULL. */
+	pfBtnInputTap		pfInputTap;
+
+	/** Events the queue refused. */
+	uint32_t			postfailures;
+
+	/** Scans since startup; wraps. The state timers count scans rather than clock time, so a scan
+	 *	sequence (e.g., a replayed trace) gives the same events whatever its pace.
+	 */
+	uint32_t			scancount;
+
+	/** Calibration table in use (used in place), or NULL for #caldefault. */
+	tBtnCalibration const *pcaltable;
+
+	/** The engine's view of the calibration (enables, and for the vertical counters, the windows in
+	 *	scans) has been brought up to date with the calibration in use.
+	 */
+	bool				calapplied;
+
+	/** Buttons enabled by the calibration. */
+	tBtnPortWord		enabled[kBtnInputWords];
+
+	/** Debounced button states, published at the end of each scan for Btn_CtxGetButtonStates().
+	 *	`seq` is even between scans, and odd while a scan is publishing; snapshot seq / 2 is in
+	 *	`copy[(seq / 2) & 1]`, and the scan publishing writes the other copy.
+	 */
+	struct sBtnStatesPub {
+#if (BTN_ENGINE == BTN_ENGINE_SME)
+		tBtnPortWord	pressed[kBtnNumPortWords];		//!< Kept up to date by the transitions; the vertical counters keep their own.
+		tBtnPortWord	stuck[kBtnNumPortWords];
+#endif
+		tBtnStatesSeq	seq;
+		tBtnStates		copy[2];
+	} states;
+
+#if (BTN_SCAN_GROUPS)
+	/** Scan groups. */
+	struct sBtnGroups {
+		uint16_t		tmperiod[BTN_SCAN_GROUPS];					//!< Sampling period of each group (ms); 0 for every scan.
+		tBtnPortWord	members[BTN_SCAN_GROUPS][kBtnNumPortWords];	//!< Enabled buttons of each group; brought up to date w/ the calibration.
+		tBtnPortWord	due[kBtnNumPortWords];						//!< Buttons sampled by the current scan.
+	} groups;
+#endif
+
+#if (BTN_CAL_MMAP)
+	/** Calibration image currently mapped by Btn_CtxMapCalibration(). */
+	void				*pcalmapped;
+	size_t				calmappedsize;
+#endif
+
+#if (BTN_BATCH_EVENTS)
+	/** Recent batches, in a ring; the one being collected is `slot[cur]`. */
+	struct sBtnBatchLog {
+		tBtnBatch	slot[kBtnBatchSlots];
+		uint32_t	seq;		//!< Sequence number of the batch being collected.
+		uint32_t	cur;		//!< Slot of the batch being collected.
+		bool		pending;	//!< The batch being collected holds at least one change.
+	} batchlog;
+#endif
+
+#if (BTN_CHORDS)
+	/** Chord recognizer.
+	 *	A press of a button that belongs to some chord is held back for the coincidence window, which
+	 *	starts w/ the first such press. When the window closes (or one of the held buttons is released),
+	 *	the held presses are looked up as one bitmask: if they form a registered chord, the chord is
+	 *	posted once one of its buttons is released, and its buttons' own press and release events are
+	 *	not posted; otherwise, the held presses are posted late, as they were.
+	 */
+	struct sBtnChords {
+		tBtnChord const	*ptbl;							//!< Registered chords (used in place), or NULL.
+		uint32_t		window;							//!< Coincidence window, in scans.
+		uint16_t		index[BTN_CHORD_SLOTS];			//!< Hash index of the table: (row + 1), or 0 for an empty slot.
+		tBtnPortWord	chordable[kBtnNumPortWords];	//!< Buttons that belong to at least one chord.
+		tBtnPortWord	held[kBtnNumPortWords];			//!< Presses held back while the window is open.
+		uint32_t		opened;							//!< Scan at which the window opened.
+		bool			collecting;						//!< The window is open.
+		tBtnChord const	*pmatched;						//!< Chord recognized, to be posted on its first release.
+		tBtnPortWord	swallow[kBtnNumPortWords];		//!< Chord buttons whose release is not to be posted.
+	} chords;
+#endif
+
+#if (BTN_GESTURES)
+	/** Gesture recognizer. Gestures are timed in scans; a press or release is noted as it is delivered,
+	 *	and the long-press and repeat deadlines of every held button are serviced in one pass at the end
+	 *	of the scan.
+	 */
+	struct sBtnGestures {
+		tBtnGesture const	*ptbl;							//!< Gesture configuration (used in place), or NULL.
+		tBtnPortWord		timing[kBtnNumPortWords];		//!< Buttons w/ a long-press or repeat pending.
+		tBtnPortWord		latched[kBtnNumPortWords];		//!< Latched state of toggle buttons.
+		uint32_t			longdue[kBoardNumButtons];		//!< Scan at which the long-press is due.
+		uint32_t			repeatdue[kBoardNumButtons];	//!< Scan at which the next repeat is due.
+		uint32_t			released[kBoardNumButtons];		//!< Scan of the latest release.
+		uint8_t				flags[kBoardNumButtons];		//!< #eBtnGestureFlags.
+	} gestures;
+#endif
+
+#if (BTN_ENGINE == BTN_ENGINE_SME)
+	/** Per-button state of the SME engine.
+	 *	Every button's SM state lives in this one block, one array per field, so a scan pass walks each
+	 *	field linearly instead of visiting a separate set of arrays in each state function.
+	 *	A button is in exactly one state at a time, so the states share the phase marker, the exit
+	 *	reasons and the state timer; a state's entry action initializes whatever it uses.
+	 */
+	struct sBtnEngine {
+		uint8_t				currentstate[kBoardNumButtons] BTN_SHARD_ALIGNED;	//!< Active state of each button's SM (#eBtnStates).
+		tBtnPhase			statephase[kBoardNumButtons] BTN_SHARD_ALIGNED;	//!< Phase within the active state.
+		tBtnReason1			evId[kBoardNumButtons] BTN_SHARD_ALIGNED;			//!< Exit reason 1.
+		tBtnReason3			reason3[kBoardNumButtons] BTN_SHARD_ALIGNED;		//!< Exit reason 3.
+		tBtnHistory			read_bits[kBoardNumButtons] BTN_SHARD_ALIGNED;	//!< Debounce shift register: the latest samples, newest in bit 0.
+		int8_t				dbcount[kBoardNumButtons] BTN_SHARD_ALIGNED;		//!< Debounce strategy's count (integrator value, samples taken).
+
+		/** Buttons whose SM is idle in "released", waiting for a twitch. Such a button is only visited
+		 *	when its input is active; an idle port word costs the scan one compare.
+		 */
+		tBtnPortWord		quiet[kBtnNumPortWords] BTN_SHARD_ALIGNED;
+
+		/** Buttons whose SM is waiting in "pressed" or "stuck" for the input to open. Such a button is
+		 *	only visited when its input is open, or its state timer has expired.
+		 */
+		tBtnPortWord		held[kBtnNumPortWords] BTN_SHARD_ALIGNED;
+
+		/** Buttons whose state timer has expired. */
+		tBtnPortWord		expired[kBtnNumPortWords] BTN_SHARD_ALIGNED;
+
+#if (BTN_ADAPTIVE_DEBOUNCE)
+		// bounce measurement and learned windows; see BtnAdaptSettled().
+		uint8_t				run[kBoardNumButtons] BTN_SHARD_ALIGNED;			//!< Steady samples so far, this debounce.
+		uint8_t				maxrun[kBoardNumButtons] BTN_SHARD_ALIGNED;		//!< Longest steady stretch that ended in a bounce, this debounce.
+		uint8_t				window[kBoardNumButtons] BTN_SHARD_ALIGNED;		//!< Learned window, in scans; 0 until something is learned.
+		uint8_t				calm[kBoardNumButtons] BTN_SHARD_ALIGNED;			//!< Consecutive debounces that fit a narrower window.
+		uint32_t			settledscan[kBoardNumButtons] BTN_SHARD_ALIGNED;	//!< Scan at which the last debounce settled.
+#endif
+	} btn;
+
+#if (BTN_COMPACT)
+	/** State timers of the SME engine, as 16-bit deadlines: the low 16 bits of the scan at which each
+	 *	expires. Every running timer is compared w/ the scan count on every scan.
+	 */
+	struct sBtnTimers {
+		uint16_t		deadline[kBoardNumButtons] BTN_SHARD_ALIGNED;		//!< Scan at which the timer expires, modulo 2^16.
+		tBtnPortWord	running[kBtnNumPortWords] BTN_SHARD_ALIGNED;		//!< Buttons w/ a timer running.
+	} timers;
+#else
+	/** State timers of the SME engine, as a hierarchical timing wheel.
+	 *	Each button has at most one timer running (its active state's), so the timers are linked into the
+	 *	wheel's slots through per-button arrays. Links hold (button ID + 1), and slots (slot + 1); 0 marks
+	 *	"none".
+	 */
+	struct sBtnTimerWheel {
+		/** Slots of each shard's wheel; a shard's timers are filed in its own wheel, so shards advance
+		 *	their timers independently.
+		 */
+		struct sBtnWheelRing {
+			uint32_t	next BTN_SHARD_ALIGNED;		//!< Next scan to process.
+			uint32_t	head[kBtnWheelSlots];			//!< First timer in each slot.
+		} ring[kBtnNumShards];
+		uint32_t	tnext[kBoardNumButtons] BTN_SHARD_ALIGNED;		//!< Next timer in the same slot.
+		uint32_t	tprev[kBoardNumButtons] BTN_SHARD_ALIGNED;		//!< Previous timer in the same slot.
+		uint32_t	expires[kBoardNumButtons] BTN_SHARD_ALIGNED;		//!< Scan at which the timer expires.
+		uint16_t	slot[kBoardNumButtons] BTN_SHARD_ALIGNED;			//!< Slot holding the timer; 0 if not running.
+	} wheel;
+#endif
+
+#if (BTN_SCAN_THREADS)
+	/** Transitions deferred by each shard's scan. Whichever thread scans a shard logs its transitions
+	 *	as (button ID << 8 | row), leaving out those that do nothing; once the scan is joined, the
+	 *	calling thread runs them shard by shard, from the top down, which is the order a single-threaded
+	 *	scan runs them in.
+	 */
+	struct sBtnShardLog {
+		uint32_t	count BTN_SHARD_ALIGNED;	//!< Entries logged.
+		bool		fault;						//!< A button's SM stopped; the scan alarm is to be disabled.
+		uint32_t	entry[kBtnShardButtons];
+	} shardlog[kBtnNumShards];
+
+	/** Worker threads; started by the instance's first scan, and kept for the life of the program. */
+	struct sBtnWorkers {
+		pthread_mutex_t	lock;
+		pthread_cond_t	start;			//!< Signalled when a scan starts.
+		pthread_cond_t	done;			//!< Signalled as each worker finishes a scan.
+		uint32_t		generation;		//!< Scans started.
+		uint32_t		idle;			//!< Workers finished with the current scan.
+		uint32_t		nthreads;		//!< Workers running; fewer than BTN_SCAN_THREADS if some failed to start.
+		bool			started;		//!< The workers have been started (or failed to start).
+		tEvQ_Event		ev;				//!< Task event of the current scan.
+		uint32_t		extra;
+
+		/** Shards left to each participant in the current scan: the calling thread, then each worker.
+		 *	The range [lo, hi) is packed as (lo | hi << 32); its owner takes shards from the bottom, and
+		 *	a participant that has run out steals from the top.
+		 */
+		struct sBtnShardQueue {
+			_Atomic uint64_t	range BTN_SHARD_ALIGNED;
+			tBtnCtx				*pctx;
+			uint32_t			self;	//!< Index of this participant.
+		} queue[BTN_SCAN_THREADS + 1];
+	} workers;
+#endif
+#endif
+
+#if (BTN_LATENCY_STATS)
+	/** Edge-to-event latency of each button. */
+	struct sBtnLatency {
+		uint32_t	edgescan[kBoardNumButtons] BTN_SHARD_ALIGNED;				//!< Scan that saw the first edge of the change being debounced.
+		uint8_t		armed[kBoardNumButtons] BTN_SHARD_ALIGNED;				//!< `edgescan` is valid.
+		uint32_t	count[kBoardNumButtons] BTN_SHARD_ALIGNED;				//!< Latencies recorded.
+		uint32_t	max[kBoardNumButtons] BTN_SHARD_ALIGNED;					//!< Longest latency recorded, in scans.
+		uint32_t	hist[kBoardNumButtons][kBtnLatBuckets] BTN_SHARD_ALIGNED;	//!< Log-linear histogram of latencies, in scans.
+		uint32_t	merged[kBtnLatBuckets];					//!< All buttons' histograms, summed; kept off the stack.
+	} latency;
+#endif
+
+#if (BTN_PROFILE)
+	/** Per-button SM profile.
+	 *	Dwell is charged to a state when it is left, so a button idle in "released" (which the scan
+	 *	doesn't visit) costs nothing to profile.
+	 */
+	struct sBtnProfile {
+		uint32_t	transitions[kBoardNumButtons][kBtnNumTransitions] BTN_SHARD_ALIGNED;	//!< Times each transition was taken.
+		uint32_t	dwell[kBoardNumButtons][kBtnNumStates] BTN_SHARD_ALIGNED;				//!< Scans spent in each state, up to its latest exit.
+		uint32_t	entered[kBoardNumButtons] BTN_SHARD_ALIGNED;							//!< Scan at which the current state was entered.
+	} profile;
+#endif
+
+#if (BTN_ENGINE == BTN_ENGINE_VERTICAL_COUNTER)
+	/** Bit-sliced state for the vertical-counter engine: the per-button SME, one bit per button.
+	 *	Each state, and each phase of a state, is a word of flags; the same bit position across the
+	 *	planes of `run` (or `left`) forms one button's counter, so the SMEs of all buttons in a port
+	 *	word advance with one set of logic operations. The planes of a step lie together, so that a
+	 *	scan walks the state once, in order; those an idle step looks at come first.
+	 */
+	struct sBtnVertCtr {
+		struct sBtnVcStep {
+			tBtnPortWord	state[kBtnVcNumStates][kBtnVcLaneWords];		//!< One-hot SM state; none set == "start".
+			tBtnPortWord	oper[kBtnVcLaneWords];							//!< In the operational phase of its state.
+			tBtnPortWord	leave[kBtnVcLaneWords];							//!< In the exit phase; takes its transition next scan.
+			tBtnPortWord	pend[kBtnVcNumEdges][kBtnVcLaneWords];			//!< Events decided, to be posted by the exit phase.
+			tBtnPortWord	last[kBtnVcLaneWords];							//!< Latest debounce sample.
+			tBtnPortWord	run[kBtnVcCountPlanes][kBtnVcLaneWords];		//!< Consecutive debounce samples equal to `last`.
+			tBtnPortWord	expired[kBtnVcLaneWords];						//!< The state timer has run out.
+			tBtnPortWord	left[kBtnVcTimerPlanes][kBtnVcLaneWords];		//!< Scans left on the state timer, less one.
+
+			// calibration, in scans, sliced the same way as the counters.
+			tBtnPortWord	presswin[kBtnVcCountPlanes][kBtnVcLaneWords];	//!< Press debounce window.
+			tBtnPortWord	releasewin[kBtnVcCountPlanes][kBtnVcLaneWords];	//!< Release debounce window.
+			tBtnPortWord	stuckwin[kBtnVcTimerPlanes][kBtnVcLaneWords];	//!< Stuck timeout, less one.
+		} step[kBtnVcSteps];
+		uint32_t		dbtimeout;											//!< Debounce timeout, less one; the same for all buttons.
+
+		tBtnPortWord	debounced[kBtnVcWords];								//!< Debounced state; 1 == pressed.
+		tBtnPortWord	stuck[kBtnVcWords];									//!< Button held past the stuck timeout.
+	} vc;
+#endif
+};
+
+#if (BTN_ENGINE == BTN_ENGINE_SME)
+/** One debounce rule. The debounce state shifts each sample into `read_bits` before asking the rule
+ *	for a verdict.
+ */
+typedef struct sBtnDebouncer {
+	/** A debounce is starting. */
+	void			(*start)(tBtnCtx *pctx, uint32_t idx);
+
+	/** Judge the latest sample.
+	 *	@param[in]	pctx		Engine instance.
+	 *	@param[in]	idx			Button ID.
+	 *	@param[in]	presswin	Press window, in scans.
+	 *	@param[in]	releasewin	Release window, in scans.
+	 *	@returns evBntPressed or evBtnReleased once the input has settled, else 0.
+	 */
+	tEvQ_EventID	(*settled)(tBtnCtx *pctx, uint32_t idx, uint32_t presswin, uint32_t releasewin);
+} tBtnDebouncer;
+
+/** State function of the button SM; the cwsw SME's handler, plus the instance the button belongs to. */
+typedef tStateReturnCodes (*pfBtnStateHandler)(tBtnCtx *pctx, ptEvQ_Event pev, uint32_t *pextra);
+#endif
+
+/** One row of the button SM's transition table. */
+typedef struct sBtnTransition {
+	uint8_t			current;							//!< State being exited.
+	tEvQ_EventID	reason1;							//!< Event that provoked the exit.
+	uint8_t			reason3;							//!< Reason for the exit.
+	uint8_t			next;								//!< State to enter.
+	void			(*transition)(tBtnCtx *pctx, tEvQ_Event ev, uint32_t extra);	//!< Transition action.
+} tBtnTransition;
+
+#if (BTN_SCAN_THREADS)
+/// Each shard's share of a port-word array must be whole cache lines.
+typedef char tBtnShardsAreWholeCacheLines[(((kBtnShardWords * sizeof(tBtnPortWord)) % kBtnCacheLine) == 0) ? 1 : -1];
+#endif
+
+#if (BTN_SPECIALIZE)
+/// The specialized scan covers one port word.
+typedef char tBtnSpecializedBoardFitsOneWord[(kBtnNumPortWords == 1) ? 1 : -1];
+#endif
+
+#if (BTN_ENGINE == BTN_ENGINE_SME) && (BTN_COMPACT)
+/// Compact exit reasons hold the SME's events in a byte.
+typedef char tBtnCompactReasonsFitAByte[((evButton_Task < 256) && (evBntPressed < 256) && (evBtnReleased < 256)) ? 1 : -1];
+#endif
+
+/** RAM taken by an engine instance, as built. */
+enum eBtnRam {
+	kBtnRamPerInstance	= sizeof(tBtnCtx),
+	kBtnRamPerButton	= (sizeof(tBtnCtx) + kBoardNumButtons - 1) / kBoardNumButtons	//!< Rounded up.
+};
+
+#if (BTN_RAM_PER_BUTTON_MAX)
+/// The features built in fit the RAM budget per button.
+typedef char tBtnRamPerButtonFitsBudget[(kBtnRamPerButton <= (BTN_RAM_PER_BUTTON_MAX)) ? 1 : -1];
+#endif
+
+/// The calibration image is used in place; its record layout must not depend on the compiler.
+typedef char tBtnCalRecordLayoutIsFixed[((sizeof(tBtnCalibration) == 12) && (sizeof(tBtnCalImageHdr) == 12)) ? 1 : -1];
+
+
 // ============================================================================
 // ----	Global Variables ------------------------------------------------------
 // ============================================================================
@@ -67,481 +684,2713 @@ tCwswSwAlarm	Btn_tmr_ButtonRead = {
 	/* .tmrstate	= */kTmrState_Enabled
 };
 
+size_t const	Btn_RamPerInstance	= kBtnRamPerInstance;
+size_t const	Btn_RamPerButton	= kBtnRamPerButton;
+
 
 // ============================================================================
 // ----	Module-level Variables ------------------------------------------------
 // ============================================================================
 
-static ptEvQ_QueueCtrlEx pBtnEvqx = NULL;
+/** Calibration used for every button when no table has been supplied. */
+static tBtnCalibration const caldefault = {
+	/* .tmPressDebounce		= */kTmButtonDebounceWindow,
+	/* .tmReleaseDebounce	= */kTmButtonDebounceWindow,
+	/* .tmStuck				= */kButtonStuckTimeoutValue,
+	/* .enabled				= */1,
+	/* .strategy			= */kBtnDebounceShiftRegister,
+	/* .group				= */0,
+	/* .reserved			= */{0}
+};
+
+/** The default instance: the board's own buttons, behind the original singleton API. */
+static tBtnCtx btndefault = {
+	.ptmr		= &Btn_tmr_ButtonRead,
+	.numbuttons	= kBoardNumButtons
+};
+
+#if (BTN_INSTANCES)
+/** Instances handed out by Btn_CtxCreate(). */
+static tBtnCtx	btnpool[BTN_INSTANCES];
+static uint32_t	btnpoolused = 0;
+#endif
 
 
 // ============================================================================
-// ----	State Functions -------------------------------------------------------
+// ----	Private Functions -----------------------------------------------------
 // ============================================================================
 
-/** @todo Move this prototype to a legitimate header - probably board level */
-extern bool di_read_next_button_input_bit(uint32_t idx);
-
-/** Button-debounce state.
- *	This routine is common for states when you're detecting a button push, and a release.
- */
-static tStateReturnCodes
-stDebounceButton(ptEvQ_Event pev, uint32_t *pextra)
+/** The button is wired to an input: always, unless the engine is specialized for the board. */
+static bool
+BtnWired(uint32_t idx)
 {
-	static tStateReturnCodes statephase[kBoardNumButtons] = {kStateUninit};
-	static tCwswClockTics tmrMyStateTimer[kBoardNumButtons] = {0}, tmrdebounce;
-	static tEvQ_EventID evId[kBoardNumButtons] = {0};
-	static uint32_t reason3[kBoardNumButtons] = {kReasonNone};
-	static uint8_t read_bits[kBoardNumButtons] = {0};
-	uint32_t thisbutton;
-
-	if(!pev)	{return 0;}
-	if(!pextra)	{return 0;}
+#if (BTN_SPECIALIZE)
+	return ((((tBtnPortWord)(BTN_WIRED_MASK)) >> (idx % kBtnBitsPerWord)) & 1) != 0;
+#else
+	UNUSED(idx);
+	return true;
+#endif
+}
 
-	thisbutton = pev->evData;
-	switch(statephase[thisbutton]++)
+/** Sample every button input once, packing the results into port words. */
+static void
+ReadInputs(tBtnCtx *pctx)
+{
+	uint32_t idx;
+	if(pctx->pfInputSource)
 	{
-	case kStateUninit:	/* on 1ste entry, execute on-entry action */
-	case kStateFinished:	/* upon return to this state after previous normal exit, execute on-entry action */
-	default:			/* for any unexpected value, restart this state. */
-		evId[thisbutton] = pev->evId;				// save exit Reason1
-		statephase[thisbutton] = kStateOperational;	// reinitialize state's phase marker unilaterally
-
-		/* for this task, we assume the transition was provoked by a non-zero bit on the most recent
-		 * DI bit read. seed our debounce var with that 1st bit.
-		 * NOTE: his line is legacy from early development. its effect is that it allows recognition
-		 * of a a switch press after 8 consecutive bits, but requires 10 consecutive bits to
-		 * recognize a switch release (the 1st 0 read is thrown away, then it needs another one to
-		 * "clear" this seeding of the initial 1).
-		 */
-		read_bits[thisbutton] = 1;
-
-		// start my state timer. remember, our call rate is 10 ms. 100ms == 10 bit readings, 640ms is 64 bit reads
-		Set(Cwsw_Clock, tmrMyStateTimer[thisbutton], kTmButtonDebounceTime);
-		break;
-
-	case kStateOperational:
-		// TM() API doesn't work w/ array syntax; copy to local scalar timer
-		tmrdebounce = tmrMyStateTimer[thisbutton];
-		// read next bit
-		read_bits[thisbutton] <<= 1;				// shift current bits left one position
-		read_bits[thisbutton] = (uint8_t)(read_bits[thisbutton] | di_read_next_button_input_bit(thisbutton));
-		if(read_bits[thisbutton] == 0)
-		{
-			// debounce done, recognized as an open (released) button
-			evId[thisbutton] = evBtnReleased;
-			reason3[thisbutton] = kReasonDebounced;
-		}
-		else if(read_bits[thisbutton] == 0xFF)
-		{
-			// debounce done, recognized as button press, advance to next state
-			evId[thisbutton] = evBntPressed;
-			reason3[thisbutton] = kReasonDebounced;
-		}
-		else if(TM(tmrdebounce))
+		pctx->pfInputSource(pctx->inputs);
+	}
+	else
+	{
+		for(idx = 0; idx < kBtnNumPortWords; ++idx)
 		{
-			reason3[thisbutton] = kReasonTimeout;
+#if (BTN_SCAN_GROUPS)
+			// only the buttons this scan samples are read; the rest keep their last reading.
+			pctx->inputs[idx] &= ~pctx->groups.due[idx];
+#else
+			pctx->inputs[idx] = 0;
+#endif
 		}
-		else
+		// the board's DI belongs to the default instance; any other reads its inputs open until it is
+		//	given a source.
+		for(idx = 0; (pctx == &btndefault) && (idx < kBoardNumButtons); ++idx)
 		{
-			--statephase[thisbutton];		// nothing of note happened, stay in this state
+#if (BTN_SCAN_GROUPS)
+			if(!((pctx->groups.due[idx / kBtnBitsPerWord] >> (idx % kBtnBitsPerWord)) & 1))	{ continue; }
+#endif
+			if(BtnWired(idx) && di_read_next_button_input_bit(idx))
+			{
+				pctx->inputs[idx / kBtnBitsPerWord] |= (tBtnPortWord)1 << (idx % kBtnBitsPerWord);
+			}
 		}
-		break;
-
-	case kStateExit:
-		// for this edition of this state, no state-specific exit action is required.
-		//	let the caller (normally the SME) know what event and what guard provoked the change.
-		pev->evId = evId[thisbutton];	// save exit reason 1 (event that provoked the exit)
-		pev->evData = thisbutton;		// save exit reason 2 (button recognized)
-		*pextra = reason3[thisbutton];	// save exit reason 3 (reason for exit (no button, button, timeout)
-		break;
 	}
+	if(pctx->pfInputTap)	{ pctx->pfInputTap(pctx->inputs); }
+}
 
-	// the next line is part of the template and should not be touched.
-	return statephase[thisbutton];
+#if (BTN_ENGINE == BTN_ENGINE_SME)
+/** This scan's sample of one button input. */
+static bool
+BtnInput(tBtnCtx *pctx, uint32_t idx)
+{
+	return ((pctx->inputs[idx / kBtnBitsPerWord] >> (idx % kBtnBitsPerWord)) & 1) != 0;
+}
+#endif
+
+// the specialized scan is unrolled, and the vertical counters' direct batch needs no bit positions.
+#if ((BTN_ENGINE == BTN_ENGINE_SME) && (!(BTN_SPECIALIZE) || (BTN_COMPACT))) \
+	|| ((BTN_ENGINE == BTN_ENGINE_VERTICAL_COUNTER) && !(BTN_VC_BATCH_DIRECT)) \
+	|| (BTN_GESTURES) || (BTN_CHORDS) || (BTN_LATENCY_STATS)
+/** Bit position of the most-significant set bit in a (non-zero) port word. */
+static uint32_t
+HighestBit(tBtnPortWord word)
+{
+#if defined(__GNUC__)
+	return (uint32_t)(kBtnBitsPerWord - 1 - __builtin_clzll(word));
+#else
+	uint32_t bit = kBtnBitsPerWord - 1;
+	while(!(word & ((tBtnPortWord)1 << bit)))	{ --bit; }
+	return bit;
+#endif
 }
+#endif
 
+/** Post an event to the button queue, counting refusals. */
+static void
+PostBtnEvent(tBtnCtx *pctx, tEvQ_Event ev)
+{
+	if(Cwsw_EvQX__PostEvent(pctx->pBtnEvqx, ev) != kErr_Lib_NoError)
+	{
+		++pctx->postfailures;
+	}
+}
 
-static tStateReturnCodes
-stStart(ptEvQ_Event pev, uint32_t *pextra)
+#if (BTN_BATCH_EVENTS) && !(BTN_VC_BATCH_DIRECT)
+/** Add one button event to the batch being collected. */
+static void
+BatchNote(tBtnCtx *pctx, tEvQ_Event ev)
 {
-	static tStateReturnCodes statephase[kBoardNumButtons] = {kStateUninit};
-	static tEvQ_EventID evId[kBoardNumButtons];
-	uint32_t thisbutton;
+	tBtnBatch *pbatch = &pctx->batchlog.slot[pctx->batchlog.cur];
+	tBtnPortWord *pmask;
 
-	if(!pev)	{ return 0; }
-	if(!pextra)	{ return 0; }
+	switch(ev.evId)
+	{
+	case evBntPressed:			pmask = pbatch->pressed;	break;
+	case evBtnReleased:			pmask = pbatch->released;	break;
+	case evButton_BtnStuck:		pmask = pbatch->stuck;		break;
+	case evButton_BtnUnstuck:	pmask = pbatch->unstuck;	break;
+	default:					return;
+	}
+	pmask[ev.evData / kBtnBitsPerWord] |= (tBtnPortWord)1 << (ev.evData % kBtnBitsPerWord);
+	pctx->batchlog.pending = true;
+}
+#endif
 
-	thisbutton = pev->evData;
-	switch(statephase[thisbutton]++)
+#if (BTN_BATCH_EVENTS)
+/** At the end of a scan, post the collected batch (if any), and start the next one. */
+static void
+BatchPost(tBtnCtx *pctx, tEvQ_Event ev)
+{
+	if(pctx->batchlog.pending)
 	{
-	case kStateUninit:	/* on 1st entry, execute on-entry action */
-	case kStateFinished:	/* upon return to this state after previous normal exit, execute on-entry action */
-	default:			/* for any unexpected value, restart this state. */
-		// generic state management, common to all states
-		statephase[thisbutton]	= kStateOperational;
-		evId[thisbutton]		= pev->evId;			// save default exit reason 1.
+		ev.evId = evButton_Batch;
+		ev.evData = pctx->batchlog.seq++;
+		PostBtnEvent(pctx, ev);
+
+		// the slot we're about to collect into holds the batch just past the oldest retained; retire it.
+		pctx->batchlog.cur = (pctx->batchlog.cur + 1) % kBtnBatchSlots;
+		(void)memset(&pctx->batchlog.slot[pctx->batchlog.cur], 0, sizeof(tBtnBatch));
+		pctx->batchlog.pending = false;
+	}
+}
+#endif
 
-		// ---- state-specific behavior ---------
-		// no state-specific behavior for this state
-//		printf("Entering %s\n", __FUNCTION__);
-		break;
+#if (BTN_ENGINE == BTN_ENGINE_SME)
+/** Bring the debounced states up to date w/ one button event. (The chord recognizer may swallow the
+ *	event; the button's state has changed all the same.)
+ */
+static void
+StatesNote(tBtnCtx *pctx, tEvQ_Event ev)
+{
+	uint32_t w = ev.evData / kBtnBitsPerWord;
+	tBtnPortWord mask = (tBtnPortWord)1 << (ev.evData % kBtnBitsPerWord);
 
-	case kStateOperational:
-		// we'll basically leave as soon as we start.
+	switch(ev.evId)
+	{
+	case evBntPressed:			pctx->states.pressed[w] |= mask;	break;
+	case evBtnReleased:			pctx->states.pressed[w] &= ~mask;	break;
+	case evButton_BtnStuck:		pctx->states.stuck[w] |= mask;		break;
+	case evButton_BtnUnstuck:	// released from "stuck" w/o an evBtnReleased.
+		pctx->states.pressed[w] &= ~mask;
+		pctx->states.stuck[w] &= ~mask;
 		break;
+	default:					break;
+	}
+}
+#endif
 
-	case kStateExit:
-		// manage the state machine: set exit reasons
-		pev->evId = evId[thisbutton];	// exit reason 1: event that provoked the exit.
-		pev->evData = thisbutton;		// exit reason 2
-		*pextra = kReasonNone;			// exit reason 3 (for debugging use in transition)
+/** At the end of a scan, publish the debounced states. */
+static void
+StatesPublish(tBtnCtx *pctx)
+{
+	uint32_t seq = BTN_SEQ_LOAD(pctx->states.seq, relaxed);
+	uint32_t next = seq + 2;
+	tBtnStates *pcopy = &pctx->states.copy[((seq / 2) + 1) & 1];
+
+	// 0 means nothing published; on wrapping, skip on to the next count that names the same copy.
+	if(!next)	{ next = 4; }
+
+	// the odd count warns readers of the copy being written; it's the one the last-but-one scan
+	//	published.
+	BTN_SEQ_STORE(pctx->states.seq, seq + 1, relaxed);
+	BTN_SEQ_FENCE(release);
+#if (BTN_ENGINE == BTN_ENGINE_VERTICAL_COUNTER)
+	(void)memcpy(pcopy->pressed, pctx->vc.debounced, sizeof(pcopy->pressed));
+	(void)memcpy(pcopy->stuck, pctx->vc.stuck, sizeof(pcopy->stuck));
+#else
+	(void)memcpy(pcopy->pressed, pctx->states.pressed, sizeof(pcopy->pressed));
+	(void)memcpy(pcopy->stuck, pctx->states.stuck, sizeof(pcopy->stuck));
+#endif
+	pcopy->scan = pctx->scancount;
+	BTN_SEQ_STORE(pctx->states.seq, next, release);
+}
 
-		// state-specific behavior
-		/* (no state-specific exit actions here) */
-//		printf("Leaving %s\n", __FUNCTION__);
-		break;
-	}
+/** Calibration of one button. */
+static tBtnCalibration const *
+BtnCal(tBtnCtx *pctx, uint32_t idx)
+{
+	return pctx->pcaltable ? &pctx->pcaltable[idx] : &caldefault;
+}
 
-	// the next line is part of the template and should not be touched.
-	return statephase[thisbutton];
+/** Convert a calibrated time to whole scans at the current scan rate, clamped to [1, limit]. */
+static uint32_t
+ScansFor(tBtnCtx *pctx, uint32_t tm, uint32_t limit)
+{
+	uint32_t scantm = (pctx->ptmr->reloadtm > 0) ? (uint32_t)pctx->ptmr->reloadtm : 1;
+	uint32_t scans = tm / scantm;
+	if(scans > limit)	{ scans = limit; }
+	return scans ? scans : 1;
 }
 
-/**	Implement the Button Released state of the SM.
+#if (BTN_ENGINE == BTN_ENGINE_SME)
+#if (BTN_SCAN_GROUPS)
+/** Scan group of a button. */
+static uint32_t
+GroupOf(tBtnCtx *pctx, uint32_t idx)
+{
+	uint32_t group = BtnCal(pctx, idx)->group;
+	return (group < BTN_SCAN_GROUPS) ? group : 0;
+}
 
- *	@note If return here is due to a stuck-button event, this state will continue to read a stream
- *		  of "1" bits from the DI layer. In that case, there will be a continual cycle between this
- *		  state, debounce-press, and pressed, then back here. \n
- *		  The default SM has a special "stuck" state, which is intended to eliminate this cycle, but
- *		  we wanted to describe the behavior if something should go wrong.
- *	@{
+/** Work out which buttons the current scan samples: the members of each group whose period ends
+ *	w/ this scan.
  */
-static tStateReturnCodes
-stButtonReleased(ptEvQ_Event pev, uint32_t *pextra)
+static void
+GroupsDue(tBtnCtx *pctx)
 {
-	static tStateReturnCodes statephase[kBoardNumButtons] = {kStateUninit};
-	uint32_t thisbutton;
-
-	if(!pev)	{return 0;}
-	if(!pextra)	{return 0;}
+	uint32_t group, w;
 
-	thisbutton = pev->evData;
-	switch(statephase[thisbutton]++)
+	(void)memset(pctx->groups.due, 0, sizeof(pctx->groups.due));
+	for(group = 0; group < BTN_SCAN_GROUPS; ++group)
 	{
-	case kStateUninit:		/* on 1st entry, execute on-entry action */
-	case kStateFinished:	/* upon return to this state after previous normal exit, execute on-entry action */
-	default:				/* for any unexpected value, restart this state. */
-		// generic state management, common to all states
-		statephase[thisbutton] = kStateOperational;	// reinitialize state's phase marker unilaterally
-
-		// ---- state-specific behavior ---------
-		// no state-specific behavior for this state
-//		printf("Entering %s\n", __FUNCTION__);
-		break;
-
-	case kStateOperational:
-		do {
-			// use local var so i can override it during debugging.
-			bool thisbit = di_read_next_button_input_bit(thisbutton);	// issue #3: pass the current button
-			if(!thisbit)
-			{
-				// stay in this state until we see a twitch on one of the button inputs.
-				//	note: in this iteration of this implementation, we're only reading "button" 0
-				--statephase[thisbutton];
-			}
-		} while(0);
-		break;
-
-	case kStateExit:
-		// manage the state machine: set exit reasons
-		// evId field (reason1) is OK as passed in.
-		pev->evData = thisbutton;		// reason2
-		*pextra = kReasonTwitchNoted;	// reason3
-
-		// state-specific behavior
-		/* (no state-specific exit actions here) */
-//		printf("Leaving %s\n", __FUNCTION__);
-		break;
+		if(pctx->scancount % ScansFor(pctx, pctx->groups.tmperiod[group], UINT32_MAX))	{ continue; }
+		for(w = 0; w < kBtnNumPortWords; ++w)
+		{
+			pctx->groups.due[w] |= pctx->groups.members[group][w];
+		}
 	}
+}
+#endif
 
-	// the next line is part of the template and should not be touched.
-	return statephase[thisbutton];
+/** Scans from one sample of a button's input to the next: 1, or w/ scan groups, its group's period. */
+static uint32_t
+SampleEvery(tBtnCtx *pctx, uint32_t idx)
+{
+#if (BTN_SCAN_GROUPS)
+	return ScansFor(pctx, pctx->groups.tmperiod[GroupOf(pctx, idx)], UINT32_MAX);
+#else
+	UNUSED(pctx);
+	UNUSED(idx);
+	return 1;
+#endif
 }
-/** @} */
 
-static tStateReturnCodes
-stDebouncePress(ptEvQ_Event pev, uint32_t *pextra)
+/** Convert a time (ms) to samples of a button's input, rounding down (at least one, at most `limit`). */
+static uint32_t
+SamplesFor(tBtnCtx *pctx, uint32_t idx, uint32_t tm, uint32_t limit)
 {
-	return stDebounceButton(pev, pextra);
+	return ScansFor(pctx, tm / SampleEvery(pctx, idx), limit);
 }
+#endif
 
-static tStateReturnCodes
-stButtonPressed(ptEvQ_Event pev, uint32_t *pextra)
+#if (BTN_GESTURES)
+/** Follow one debounced edge (or stuck report) of a button, posting any gesture it completes. */
+static void
+GestureNote(tBtnCtx *pctx, tEvQ_Event ev)
 {
-	static tStateReturnCodes statephase[kBoardNumButtons] = {kStateUninit};
-	static tCwswClockTics tmrPressedStateTimer[kBoardNumButtons] = {0}, tmrPressed;
-	static tEvQ_EventID evId[kBoardNumButtons] = {0};
-	static uint32_t reason2[kBoardNumButtons] = {0};
-	static uint32_t reason3[kBoardNumButtons] = {kReasonNone};
-	uint32_t thisbutton;
+	uint32_t idx = ev.evData;
+	uint32_t w = idx / kBtnBitsPerWord;
+	tBtnPortWord mask = (tBtnPortWord)1 << (idx % kBtnBitsPerWord);
+	tBtnGesture const *pgst;
+	uint8_t flags;
 
-	if(!pev)	{return 0;}
-	if(!pextra)	{return 0;}
+	if(!pctx->gestures.ptbl || (idx >= pctx->numbuttons))	{ return; }
+	pgst = &pctx->gestures.ptbl[idx];
+	flags = pctx->gestures.flags[idx];
 
-	thisbutton = pev->evData;
-	switch(statephase[thisbutton]++)
+	switch(ev.evId)
 	{
-	case kStateUninit:
-	case kStateFinished:
-	default:
-		evId[thisbutton] = pev->evId;				// save exit Reason1
-		reason3[thisbutton] = kReasonNone;			// save default exit Reason3
-		statephase[thisbutton] = kStateOperational;	// reinitialize state's phase marker unilaterally
-
-		/* for this task, we stay here as long as the button remains pressed, or until the timeout
-		 * period expires. a "release" is seen as a zero bit on the bit input stream.
-		 */
-		Set(Cwsw_Clock, tmrPressedStateTimer[thisbutton], kButtonStuckTimeoutValue);
-//		printf("Entering %s\n", __FUNCTION__);
-		break;
+	case evBntPressed:
+		flags &= (uint8_t)~(kGstLongPending | kGstRepeatPending | kGstNoClick);
+		if(	(flags & kGstClickOpen) &&
+			((pctx->scancount - pctx->gestures.released[idx]) <= ScansFor(pctx, pgst->tmDoubleClick, UINT32_MAX)))
+		{
+			// a third press starts a new pair.
+			flags |= kGstNoClick;
+			ev.evId = evButton_DoubleClick;
+			PostBtnEvent(pctx, ev);
+		}
+		flags &= (uint8_t)~kGstClickOpen;
 
-	case kStateOperational:
-		do {
-			bool thisbit;
-			tmrPressed = tmrPressedStateTimer[thisbutton];
-			// use local var so i can override it during debugging.
-			thisbit = di_read_next_button_input_bit(thisbutton);
-			if(!thisbit)
-			{
-				// button might have been released, go to debounce-release state to confirm
-				reason2[thisbutton] = thisbutton;
-				reason3[thisbutton] = kReasonTwitchNoted;
-			}
-			else if(TM(tmrPressed))
+		if(pgst->toggle)
+		{
+			pctx->gestures.latched[w] ^= mask;
+			ev.evId = evButton_Toggle;
+			ev.evData = idx | ((pctx->gestures.latched[w] & mask) ? kBtnToggledOn : 0);
+			PostBtnEvent(pctx, ev);
+		}
+		if(pgst->tmLongPress)
+		{
+			pctx->gestures.longdue[idx] = pctx->scancount + ScansFor(pctx, pgst->tmLongPress, UINT32_MAX);
+			flags |= kGstLongPending;
+		}
+		if(pgst->tmRepeatDelay)
+		{
+			pctx->gestures.repeatdue[idx] = pctx->scancount + ScansFor(pctx, pgst->tmRepeatDelay, UINT32_MAX);
+			flags |= kGstRepeatPending;
+		}
+		break;
+
+	case evBtnReleased:
+		if(pgst->tmDoubleClick && !(flags & kGstNoClick))
+		{
+			flags |= kGstClickOpen;
+			pctx->gestures.released[idx] = pctx->scancount;
+		}
+		flags &= (uint8_t)~(kGstLongPending | kGstRepeatPending | kGstNoClick);
+		break;
+
+	case evButton_BtnStuck:
+		flags &= (uint8_t)~(kGstLongPending | kGstRepeatPending | kGstClickOpen);
+		flags |= kGstNoClick;
+		break;
+
+	default:
+		return;
+	}
+
+	pctx->gestures.flags[idx] = flags;
+	if(flags & (kGstLongPending | kGstRepeatPending))	{ pctx->gestures.timing[w] |= mask; }
+	else												{ pctx->gestures.timing[w] &= ~mask; }
+}
+
+/** End-of-scan service: post the long-presses and repeats that have come due. */
+static void
+GestureScan(tBtnCtx *pctx, tEvQ_Event ev)
+{
+	uint32_t w;
+
+	for(w = 0; w < kBtnNumPortWords; ++w)
+	{
+		tBtnPortWord pending = pctx->gestures.timing[w];
+		while(pending)
+		{
+			uint32_t bit = HighestBit(pending);
+			tBtnPortWord mask = (tBtnPortWord)1 << bit;
+			uint32_t idx = (w * kBtnBitsPerWord) + bit;
+			uint8_t flags = pctx->gestures.flags[idx];
+			pending &= ~mask;
+
+			ev.evData = idx;
+			if((flags & kGstLongPending) && ((int32_t)(pctx->scancount - pctx->gestures.longdue[idx]) >= 0))
 			{
-				// we've been too long in the pressed-button state, there might be a stuck button
-				reason2[thisbutton] = 0;
-				reason3[thisbutton] = kReasonTimeout;
+				flags = (uint8_t)((flags & ~kGstLongPending) | kGstNoClick);
+				ev.evId = evButton_LongPress;
+				PostBtnEvent(pctx, ev);
 			}
-			else
+			if((flags & kGstRepeatPending) && ((int32_t)(pctx->scancount - pctx->gestures.repeatdue[idx]) >= 0))
 			{
-				--statephase[thisbutton];	// nothing of note happened, stay in this state
+				pctx->gestures.repeatdue[idx] = pctx->scancount + ScansFor(pctx, pctx->gestures.ptbl[idx].tmRepeatRate, UINT32_MAX);
+				flags |= kGstNoClick;
+				ev.evId = evButton_Repeat;
+				PostBtnEvent(pctx, ev);
 			}
-		} while(0);
-		break;
 
-	case kStateExit:
-		// for this edition of this state, no state-specific exit action is required.
-		//	let the caller (normally the SME) know what event and what guard provoked the change.
-		pev->evId = evId[thisbutton];		// save exit reason 1 (event that provoked the exit)
-		pev->evData = reason2[thisbutton];	// save exit reason 2 (button recognized)
-		*pextra = reason3[thisbutton];		// save exit reason 3 (reason for exit (no button, button, timeout)
-//		printf("Leaving %s\n", __FUNCTION__);
-		break;
+			pctx->gestures.flags[idx] = flags;
+			if(!(flags & (kGstLongPending | kGstRepeatPending)))	{ pctx->gestures.timing[w] &= ~mask; }
+		}
 	}
+}
+#endif
 
-	// the next line is part of the template and should not be touched.
-	return statephase[thisbutton];
+#if !(BTN_VC_BATCH_DIRECT)
+/** Hand one button event to the batch being collected, or post it; then to the gesture recognizer. */
+static void
+DeliverBtnEvent(tBtnCtx *pctx, tEvQ_Event ev)
+{
+#if (BTN_BATCH_EVENTS)
+	BatchNote(pctx, ev);
+#else
+	PostBtnEvent(pctx, ev);
+#endif
+#if (BTN_GESTURES)
+	GestureNote(pctx, ev);
+#endif
 }
+#endif
 
-static tStateReturnCodes
-stDebounceRelease(ptEvQ_Event pev, uint32_t *pextra)
+#if (BTN_CHORDS)
+/** Hash index slot at which to start looking for a set of buttons. */
+static uint32_t
+ChordHash(tBtnPortWord const buttons[kBtnNumPortWords])
 {
-	return stDebounceButton(pev, pextra);
+	uint64_t h = 0;
+	uint32_t w;
+	for(w = 0; w < kBtnNumPortWords; ++w)
+	{
+		h = (h ^ buttons[w]) * 0x9E3779B97F4A7C15ULL;
+	}
+	return (uint32_t)(h >> 32) & (BTN_CHORD_SLOTS - 1);
 }
 
-static tStateReturnCodes
-stButtonStuck(ptEvQ_Event pev, uint32_t *pextra)
+/** Registered chord made up of exactly these buttons, or NULL. */
+static tBtnChord const *
+ChordLookup(tBtnCtx *pctx, tBtnPortWord const buttons[kBtnNumPortWords])
 {
-	static tStateReturnCodes statephase[kBoardNumButtons] = {kStateUninit};
-	static tEvQ_EventID evId[kBoardNumButtons] = {0};
-	uint32_t thisbutton;
+	uint32_t slot = ChordHash(buttons);
+	while(pctx->chords.index[slot])
+	{
+		tBtnChord const *pchord = &pctx->chords.ptbl[pctx->chords.index[slot] - 1];
+		if(!memcmp(pchord->buttons, buttons, sizeof(pchord->buttons)))	{ return pchord; }
+		slot = (slot + 1) & (BTN_CHORD_SLOTS - 1);
+	}
+	return NULL;
+}
 
-	if(!pev)	{return 0;}
-	if(!pextra)	{return 0;}
+/** Close the coincidence window: recognize the chord, or post the held presses. */
+static void
+ChordClose(tBtnCtx *pctx, tEvQ_Event ev)
+{
+	uint32_t w;
 
-	thisbutton = pev->evData;
-	switch(statephase[thisbutton]++)
+	pctx->chords.collecting = false;
+	pctx->chords.pmatched = ChordLookup(pctx, pctx->chords.held);
+	if(pctx->chords.pmatched)
 	{
-	case kStateUninit:	/* on 1st entry, execute on-entry action */
-	case kStateFinished:	/* upon return to this state after previous normal exit, execute on-entry action */
-	default:			/* for any unexpected value, restart this state. */
-		evId[thisbutton] = pev->evId;	// save exit Reason1
-//		printf("Entering %s\n", __FUNCTION__);
-		break;
-
-	case kStateOperational:
-		do {
-			bool thisbit = di_read_next_button_input_bit(0);
-			if(thisbit)
+		for(w = 0; w < kBtnNumPortWords; ++w)	{ pctx->chords.swallow[w] |= pctx->chords.held[w]; }
+	}
+	else
+	{
+		ev.evId = evBntPressed;
+		for(w = 0; w < kBtnNumPortWords; ++w)
+		{
+			tBtnPortWord held = pctx->chords.held[w];
+			while(held)
 			{
-				// stay in this state as long as we read a "1" bit
-				--statephase[thisbutton];
+				uint32_t bit = HighestBit(held);
+				held &= ~((tBtnPortWord)1 << bit);
+				ev.evData = (w * kBtnBitsPerWord) + bit;
+				DeliverBtnEvent(pctx, ev);
 			}
-		} while(0);
-		break;
+		}
+	}
+	(void)memset(pctx->chords.held, 0, sizeof(pctx->chords.held));
+}
 
-	case kStateExit:
-		// for this edition of this state, no state-specific exit action is required.
-		//	let the caller (normally the SME) know what event and what guard provoked the change.
-		pev->evId = evId[thisbutton];	// save exit reason 1 (event that provoked the exit)
+/** Pass one button event through the chord recognizer.
+ *	@returns true if the recognizer has taken the event; it is not to be posted.
+ */
+static bool
+ChordFilter(tBtnCtx *pctx, tEvQ_Event ev)
+{
+	uint32_t w = ev.evData / kBtnBitsPerWord;
+	tBtnPortWord mask = (tBtnPortWord)1 << (ev.evData % kBtnBitsPerWord);
 
-		// there's one and only one reason we leave this state, no reason for supplying reasons.
-		//	However, to allow the transition action to make an informed decision, indicate a unique
-		//	exit code.
-		pev->evData = thisbutton;
-		*pextra = kReasonButtonUnstuck;
-//		printf("Leaving %s\n", __FUNCTION__);
-		break;
-	}
+	switch(ev.evId)
+	{
+	case evBntPressed:
+		// one chord at a time; while one is held, other presses go through.
+		if(!(pctx->chords.chordable[w] & mask) || pctx->chords.pmatched)	{ return false; }
+		if(!pctx->chords.collecting)
+		{
+			pctx->chords.collecting = true;
+			pctx->chords.opened = pctx->scancount;
+		}
+		pctx->chords.held[w] |= mask;
+		return true;
 
-	// the next line is part of the template and should not be touched.
-	return statephase[thisbutton];
-}
+	case evBtnReleased:
+		if(pctx->chords.collecting && (pctx->chords.held[w] & mask))
+		{
+			ChordClose(pctx, ev);
+		}
+		if(pctx->chords.swallow[w] & mask)
+		{
+			pctx->chords.swallow[w] &= ~mask;
+			if(pctx->chords.pmatched)
+			{
+				ev.evId = evButton_Chord;
+				ev.evData = pctx->chords.pmatched->id;
+				pctx->chords.pmatched = NULL;
+				PostBtnEvent(pctx, ev);
+			}
+			return true;
+		}
+		return false;
 
+	case evButton_BtnStuck:
+		// a chord button held until stuck isn't a chord; the stuck and unstuck events go through.
+		if(pctx->chords.swallow[w] & mask)
+		{
+			pctx->chords.swallow[w] &= ~mask;
+			pctx->chords.pmatched = NULL;
+		}
+		return false;
 
-// ============================================================================
-// ----	Transition Functions --------------------------------------------------
-// ============================================================================
+	default:
+		return false;
+	}
+}
 
-/** Do-nothing transition function.
- *	This is entirely a debugging aid, it is not required by the transition table.
- */
+/** End-of-scan service: close the coincidence window once it has run its course. */
 static void
-NullTransition(tEvQ_Event ev, uint32_t extra)
+ChordScan(tBtnCtx *pctx, tEvQ_Event ev)
 {
-	UNUSED(ev);
-	UNUSED(extra);
-//	printf("Transition: ev: %i, Button: %i, Transition ID: %i\n", ev.evId, ev.evData, extra);
+	if(pctx->chords.collecting && ((pctx->scancount - pctx->chords.opened) >= pctx->chords.window))
+	{
+		ChordClose(pctx, ev);
+	}
 }
+#endif
 
-/** Transition Function.
- * 	This function notifies the world of a state change in our button-reading SM.
- * 	Not sure it really matters to our design, if we post this event in the exit function vs. the
- * 	transition; philosophically, it makes sense for the state to notify the world of its own status
- * 	change, but actually (as realized in this implementation) it does not affect the timing of the
- * 	event posting, in that both the exit action and the transition function are executed in the same
- * 	instance of the SME. the one (small) factor that tilts me towards the transition function as the
- * 	poster of note, is that philosophically, the exit action is supposed to be atomic and robust (as
- * 	in, cannot fail), but in our system, the posting of an event can fail.
- *
- * 	we rely on the state providing the event detail to be posted.
+#if (BTN_ENGINE == BTN_ENGINE_SME) && (BTN_COMPACT)
+/** Mark every timer of one shard that expires w/ the current scan.
+ *	Costs a compare per running timer; a shard w/ none running costs a read of each of its port words.
  */
 static void
-NotifyBtnStateChg(tEvQ_Event ev, uint32_t extra)
+TimersRun(tBtnCtx *pctx, uint32_t shard)
 {
-	switch(extra)
+	uint32_t first = shard * kBtnShardWords;
+	uint32_t idxword = first + kBtnShardWords;
+	uint16_t now = (uint16_t)pctx->scancount;
+
+	if(idxword > kBtnNumPortWords)	{ idxword = kBtnNumPortWords; }
+	while(idxword-- > first)
 	{
-	case kReasonDebounced:
-		// evId indicates button press or release
-		// evData indicates which button
-		// not much to do here except validate
-		switch(ev.evId)
+		tBtnPortWord running = pctx->timers.running[idxword];
+		while(running)
 		{
-		case evBtnReleased:	// button has been released
-		case evBntPressed:	// state change to Pressed state
-			break;
+			uint32_t bit = HighestBit(running);
+			uint32_t idx = (idxword * kBtnBitsPerWord) + bit;
+			tBtnPortWord mask = (tBtnPortWord)1 << bit;
 
-		default:
-			ev.evId = 0;
-			break;
+			running &= ~mask;
+			if((int16_t)(uint16_t)(now - pctx->timers.deadline[idx]) >= 0)
+			{
+				pctx->timers.running[idxword] &= ~mask;
+				pctx->btn.expired[idxword] |= mask;
+			}
 		}
-		break;
+	}
+}
 
-	case kReasonTimeout:
-		ev.evId = evButton_BtnStuck;
-		break;
+/** (Re)start a button's state timer.
+ *	@param[in]	idx		Button ID.
+ *	@param[in]	tm		Timeout (ms), rounded down to whole scans (at least one, at most
+ *						#kBtnTimerMaxScans).
+ */
+static void
+BtnTimerStart(tBtnCtx *pctx, uint32_t idx, uint32_t tm)
+{
+	tBtnPortWord mask = (tBtnPortWord)1 << (idx % kBtnBitsPerWord);
+	pctx->btn.expired[idx / kBtnBitsPerWord] &= ~mask;
+	pctx->timers.deadline[idx] = (uint16_t)(pctx->scancount + ScansFor(pctx, tm, kBtnTimerMaxScans));
+	pctx->timers.running[idx / kBtnBitsPerWord] |= mask;
+}
 
-	case kReasonButtonUnstuck:
-		ev.evId = evButton_BtnUnstuck;
-		break;
+/** Stop a button's state timer, and forget any expiry. */
+static void
+BtnTimerStop(tBtnCtx *pctx, uint32_t idx)
+{
+	tBtnPortWord mask = (tBtnPortWord)1 << (idx % kBtnBitsPerWord);
+	pctx->timers.running[idx / kBtnBitsPerWord] &= ~mask;
+	pctx->btn.expired[idx / kBtnBitsPerWord] &= ~mask;
+}
+#endif
 
-	default:
-		ev.evId = 0;
-		break;
+#if (BTN_ENGINE == BTN_ENGINE_SME) && !(BTN_COMPACT)
+/** Take a button's timer out of the wheel, if it's there. */
+static void
+WheelUnlink(tBtnCtx *pctx, uint32_t idx)
+{
+	struct sBtnWheelRing *pring = &pctx->wheel.ring[idx / kBtnShardButtons];
+	uint32_t slot = pctx->wheel.slot[idx];
+	uint32_t next, prev;
+
+	if(!slot)	{ return; }
+	next = pctx->wheel.tnext[idx];
+	prev = pctx->wheel.tprev[idx];
+	if(prev)	{ pctx->wheel.tnext[prev - 1] = next; }
+	else		{ pring->head[slot - 1] = next; }
+	if(next)	{ pctx->wheel.tprev[next - 1] = prev; }
+	pctx->wheel.slot[idx] = 0;
+}
+
+/** File a button's timer in the slot for its expiry, in its shard's wheel. */
+static void
+WheelLink(tBtnCtx *pctx, uint32_t idx)
+{
+	struct sBtnWheelRing *pring = &pctx->wheel.ring[idx / kBtnShardButtons];
+	uint32_t expires = pctx->wheel.expires[idx];
+	uint32_t delta = expires - pring->next;
+	uint32_t slot;
+
+	if((int32_t)delta < 0)
+	{
+		// already due: the next scan processed.
+		slot = pring->next & (kBtnWheelL0Slots - 1);
 	}
-	if(ev.evId)
+	else if(delta < ((uint32_t)1 << kBtnWheelL0Bits))
+	{
+		slot = expires & (kBtnWheelL0Slots - 1);
+	}
+	else
 	{
-		(void)Cwsw_EvQX__PostEvent(pBtnEvqx, ev);
+		uint32_t level = 1;
+		uint32_t shift = kBtnWheelL0Bits;
+
+		if(delta >= ((uint32_t)1 << kBtnWheelSpanBits))
+		{
+			// beyond the wheel; park in the farthest slot, and re-file when that slot is cascaded.
+			delta = ((uint32_t)1 << kBtnWheelSpanBits) - 1;
+			expires = pring->next + delta;
+		}
+		while(delta >= ((uint32_t)1 << (shift + kBtnWheelLnBits)))
+		{
+			++level;
+			shift += kBtnWheelLnBits;
+		}
+		slot = kBtnWheelL0Slots + ((level - 1) * kBtnWheelLnSlots) + ((expires >> shift) & (kBtnWheelLnSlots - 1));
 	}
+
+	pctx->wheel.tnext[idx] = pring->head[slot];
+	pctx->wheel.tprev[idx] = 0;
+	if(pring->head[slot])	{ pctx->wheel.tprev[pring->head[slot] - 1] = idx + 1; }
+	pring->head[slot] = idx + 1;
+	pctx->wheel.slot[idx] = (uint16_t)(slot + 1);
 }
 
+/** Re-file every timer in one slot of an upper level, as it comes within reach of the level below.
+ *	@returns the slot's index within its level; 0 means the level has wrapped, and the level above is
+ *	due to cascade too.
+ */
+static uint32_t
+WheelCascade(tBtnCtx *pctx, struct sBtnWheelRing *pring, uint32_t level)
+{
+	uint32_t shift = kBtnWheelL0Bits + ((level - 1) * kBtnWheelLnBits);
+	uint32_t index = (pring->next >> shift) & (kBtnWheelLnSlots - 1);
+	uint32_t slot = kBtnWheelL0Slots + ((level - 1) * kBtnWheelLnSlots) + index;
+	uint32_t list = pring->head[slot];
 
-/* the button reads use the following state machine:
- * start -> released -> debounce-press -> pressed -> debounce-release
- * 				^				|			|               |
- * 				+-------- timeout (stuck)  -/               |
- * 				\-------------------------------------------/ (unimportant if debounce achieved, or if timeout)
- *
- *	~these transitions are in the same order as listed in the design document.~ (not anymore)
+	pring->head[slot] = 0;
+	while(list)
+	{
+		uint32_t idx = list - 1;
+		list = pctx->wheel.tnext[idx];
+		pctx->wheel.slot[idx] = 0;
+		WheelLink(pctx, idx);
+	}
+	return index;
+}
+
+/** Advance one shard's wheel to the current scan, marking every timer that expires on the way.
+ *	Costs one slot per scan, plus one step per timer that expires or moves down a level.
  */
-static tTransitionTable tblTransitions[] = {
-	// current				Reason1					Reason2		Reason3					Next State			Transition Func
-	{ stStart,				evButton_Task,	0xFF,	kReasonNone,			stButtonReleased,	NullTransition		},	// normal termination
+static void
+WheelRun(tBtnCtx *pctx, uint32_t shard)
+{
+	struct sBtnWheelRing *pring = &pctx->wheel.ring[shard];
 
-	{ stButtonReleased,		evButton_Task,	0xFF,	kReasonTwitchNoted,		stDebouncePress,	NullTransition		},	// normal termination: non-0 bit seen @ button
+	while((int32_t)(pctx->scancount - pring->next) >= 0)
+	{
+		uint32_t index = pring->next & (kBtnWheelL0Slots - 1);
+		uint32_t list, level;
 
-	{ stDebouncePress,		evBntPressed,	0xFF,	kReasonDebounced,		stButtonPressed,	NotifyBtnStateChg	},	// normal termination (debounced input is 0xFF)
-	{ stDebouncePress,		evBtnReleased,	0xFF,	kReasonDebounced,		stButtonReleased,	NullTransition		},	// debounced input is 0. no need to post event, since debounced state hasn't changed.
-	{ stDebouncePress,		evButton_Task,	0xFF,	kReasonTimeout,			stButtonReleased,	NullTransition		},	// debounce timeout
+		for(level = 1; !index && (level <= kBtnWheelUpper); ++level)
+		{
+			index = WheelCascade(pctx, pring, level);
+		}
 
-	{ stButtonPressed,		evButton_Task,	0xFF,	kReasonTwitchNoted,		stDebounceRelease,	NullTransition		},
-	{ stButtonPressed,		evButton_Task,	0xFF,	kReasonTimeout,			stButtonStuck,		NotifyBtnStateChg	},	// button stuck, go directly back to "stuck" state
+		index = pring->next & (kBtnWheelL0Slots - 1);
+		list = pring->head[index];
+		pring->head[index] = 0;
+		while(list)
+		{
+			uint32_t idx = list - 1;
+			list = pctx->wheel.tnext[idx];
+			pctx->wheel.slot[idx] = 0;
+			pctx->btn.expired[idx / kBtnBitsPerWord] |= (tBtnPortWord)1 << (idx % kBtnBitsPerWord);
+		}
+		++pring->next;
+	}
+}
 
-	{ stDebounceRelease,	evBtnReleased,	0xFF,	kReasonDebounced,		stButtonReleased,	NotifyBtnStateChg	},
-	{ stDebounceRelease,	evBntPressed,	0xFF,	kReasonDebounced,		stButtonPressed,	NullTransition		},
+/** (Re)start a button's state timer.
+ *	@param[in]	idx		Button ID.
+ *	@param[in]	tm		Timeout (ms), rounded down to whole scans (at least one).
+ */
+static void
+BtnTimerStart(tBtnCtx *pctx, uint32_t idx, uint32_t tm)
+{
+	WheelUnlink(pctx, idx);
+	pctx->btn.expired[idx / kBtnBitsPerWord] &= ~((tBtnPortWord)1 << (idx % kBtnBitsPerWord));
+	pctx->wheel.expires[idx] = pctx->scancount + ScansFor(pctx, tm, UINT32_MAX);
+	WheelLink(pctx, idx);
+}
 
-	// in the interests of simplicity (MVP), we'll jump directly back to the Released state.
-	//	we could insert another instance of the debouncer, but except for transition time, the end effect will be the same.
-	{ stButtonStuck,		evButton_Task,	0xFF,	kReasonButtonUnstuck,	stButtonReleased,	NotifyBtnStateChg	},
-};
+/** Stop a button's state timer, and forget any expiry. */
+static void
+BtnTimerStop(tBtnCtx *pctx, uint32_t idx)
+{
+	WheelUnlink(pctx, idx);
+	pctx->btn.expired[idx / kBtnBitsPerWord] &= ~((tBtnPortWord)1 << (idx % kBtnBitsPerWord));
+}
+#endif
 
+#if (BTN_ENGINE == BTN_ENGINE_SME)
+/** The button's state timer has expired. */
+static bool
+BtnTimerExpired(tBtnCtx *pctx, uint32_t idx)
+{
+	return ((pctx->btn.expired[idx / kBtnBitsPerWord] >> (idx % kBtnBitsPerWord)) & 1) != 0;
+}
 
-// ============================================================================
-// ----	Public Functions ------------------------------------------------------
-// ============================================================================
+/** Mask of the low `scans` bits of a debounce shift register. */
+static uint32_t
+WindowMask(uint32_t scans)
+{
+	return (scans >= 32) ? ~(uint32_t)0 : (((uint32_t)1 << scans) - 1);
+}
+#endif
 
-/** Button handler.
- *	This version is specifically tied to the GTK board. It is a prime candidate for refactoring once
- *	we add support for more boards.
- *
- *	This handler needs to make the adaptation between our array of button state machines (one SM for
- *	each button), and the single-instance SME.
+#if (BTN_LATENCY_STATS)
+/** Histogram bucket of a latency, in scans. */
+static uint32_t
+LatBucket(uint32_t scans)
+{
+	uint32_t exp;
+	if(scans < 2 * kBtnLatSubBuckets)	{ return scans; }
+	exp = HighestBit(scans);
+	if(exp >= kBtnLatMaxExp)			{ return kBtnLatBuckets - 1; }
+	return ((exp - kBtnLatSubBits) * kBtnLatSubBuckets) + (scans >> (exp - kBtnLatSubBits));
+}
+
+/** Longest latency, in scans, that falls in a histogram bucket. */
+static uint32_t
+LatBucketTop(uint32_t bucket)
+{
+	uint32_t shift;
+	if(bucket < 2 * kBtnLatSubBuckets)	{ return bucket; }
+	shift = (bucket / kBtnLatSubBuckets) - 1;
+	return (((bucket % kBtnLatSubBuckets) + kBtnLatSubBuckets + 1) << shift) - 1;
+}
+
+/** Latency, in scans, at or below which `pct` percent of the recorded latencies fall.
+ *	Reported as the top of the bucket holding that percentile, but no more than `max`.
  */
-void
-Btn_tsk_ButtonRead(tEvQ_Event ev, uint32_t extra)	// uses DI lower layers
+static uint32_t
+LatPercentile(uint32_t const hist[kBtnLatBuckets], uint32_t count, uint32_t max, uint32_t pct)
 {
-	static pfStateHandler currentstate[kBoardNumButtons] = {NULL};
-	uint32_t idxbutton = TABLE_SIZE(currentstate);
+	uint32_t target = (uint32_t)((((uint64_t)count * pct) + 99) / 100);
+	uint32_t seen = 0, bucket, top;
 
-	while(idxbutton--)
+	for(bucket = 0; bucket < kBtnLatBuckets - 1; ++bucket)
 	{
-		if(!currentstate[idxbutton])	{ currentstate[idxbutton] = stStart; }
+		seen += hist[bucket];
+		if(seen >= target)	{ break; }
+	}
+	top = LatBucketTop(bucket);
+	return (top < max) ? top : max;
+}
+#endif
+
+#if (BTN_ENGINE == BTN_ENGINE_SME) && (BTN_ADAPTIVE_DEBOUNCE)
+/** Debounce window to use, in samples, for one direction of change.
+ *	@param[in]	idx			Button ID.
+ *	@param[in]	calibrated	The button's calibrated window for this direction; the upper bound.
+ */
+static uint32_t
+BtnAdaptWindow(tBtnCtx *pctx, uint32_t idx, uint32_t calibrated)
+{
+	uint32_t window = pctx->btn.window[idx];
+	return (!window || (window > calibrated)) ? calibrated : window;
+}
 
-		ev.evData = idxbutton;
-		currentstate[idxbutton] = Cwsw_Sme__SME(
-				tblTransitions, TABLE_SIZE(tblTransitions),
-				currentstate[idxbutton], ev, extra);
+/** A debounce is starting: begin measuring its bounce.
+ *	A debounce that starts soon after the previous one settled suggests that one settled in the middle
+ *	of a bounce; the steady stretch in between counts as part of the bounce.
+ *	@param[in]	idx			Button ID.
+ *	@param[in]	ceiling		The larger of the button's calibrated windows, in samples.
+ */
+static void
+BtnAdaptStart(tBtnCtx *pctx, uint32_t idx, uint32_t ceiling)
+{
+	uint32_t gap = (pctx->scancount - pctx->btn.settledscan[idx]) / SampleEvery(pctx, idx);
 
-		if(!currentstate[idxbutton])
+	pctx->btn.run[idx] = 0;
+	pctx->btn.maxrun[idx] = 0;
+	if(pctx->btn.window[idx] && (gap < ceiling))
+	{
+		uint32_t fit = gap + 1 + kBtnAdaptMargin;
+		if(fit > ceiling)	{ fit = ceiling; }
+		if(fit > pctx->btn.window[idx])
 		{
-			// disable alarm that launches this SME via its event.
-			//	if restarted, we'll resume in the current state
-			//	need a way to restart w/ the init state.
-			Btn_tmr_ButtonRead.tmrstate = kTmrState_Disabled;
+			pctx->btn.window[idx] = (uint8_t)fit;
+			pctx->btn.calm[idx] = 0;
 		}
-	}	// idxbutton
+	}
 }
 
+/** Account for the latest sample, already shifted into the debounce register. */
+static void
+BtnAdaptSample(tBtnCtx *pctx, uint32_t idx)
+{
+	uint32_t bits = pctx->btn.read_bits[idx];
+	if(pctx->btn.run[idx] && ((bits ^ (bits >> 1)) & 1))
+	{
+		// the input moved: the steady stretch that just ended was bounce, not the final level.
+		if(pctx->btn.run[idx] > pctx->btn.maxrun[idx])	{ pctx->btn.maxrun[idx] = pctx->btn.run[idx]; }
+		pctx->btn.run[idx] = 1;
+	}
+	else if(pctx->btn.run[idx] < UINT8_MAX)
+	{
+		++pctx->btn.run[idx];
+	}
+}
 
-/** Set button event parameters.
+/** A debounce has settled: fit the button's window to the bounce just measured.
+ *	The window must outlast the longest steady stretch within a bounce, or the debounce could settle
+ *	in the middle of one. It widens at once when a bounce calls for it, and narrows one sample at a
+ *	time, only after a run of debounces that would all have settled within the narrower window.
+ *	@param[in]	idx			Button ID.
+ *	@param[in]	ceiling		The larger of the button's calibrated windows, in samples.
  */
-void
-Btn_SetQueue(tEvQ_EventID const evId, const ptEvQ_QueueCtrlEx pEvqx)
+static void
+BtnAdaptSettled(tBtnCtx *pctx, uint32_t idx, uint32_t ceiling)
 {
-	// set queue for button activity
-	pBtnEvqx = pEvqx;
-	// set parameters for timer expiration notifications
-	Btn_tmr_ButtonRead.pEvQX = pEvqx;
-	Btn_tmr_ButtonRead.evid = evId;
+	uint32_t fit = pctx->btn.maxrun[idx] + 1 + kBtnAdaptMargin;
+	uint32_t window = pctx->btn.window[idx] ? pctx->btn.window[idx] : ceiling;
+
+	if(fit < BTN_ADAPT_MIN_SAMPLES)	{ fit = BTN_ADAPT_MIN_SAMPLES; }
+	if(fit > ceiling)				{ fit = ceiling; }
+
+	if(fit >= window)
+	{
+		window = fit;
+		pctx->btn.calm[idx] = 0;
+	}
+	else if(++pctx->btn.calm[idx] >= kBtnAdaptNarrowAfter)
+	{
+		--window;
+		pctx->btn.calm[idx] = 0;
+	}
+	pctx->btn.window[idx] = (uint8_t)window;
+	pctx->btn.settledscan[idx] = pctx->scancount;
+}
+
+/** A debounce gave up without settling: go back to the calibrated window, and learn again. */
+static void
+BtnAdaptUnsettled(tBtnCtx *pctx, uint32_t idx)
+{
+	pctx->btn.window[idx] = 0;
+	pctx->btn.calm[idx] = 0;
+}
+#endif
+
+/** Bring the engine's view of the calibration up to date with the calibration in use. */
+static void
+ApplyCalibration(tBtnCtx *pctx)
+{
+	uint32_t idx;
+
+	(void)memset(pctx->enabled, 0, sizeof(pctx->enabled));
+#if (BTN_SCAN_GROUPS)
+	(void)memset(pctx->groups.members, 0, sizeof(pctx->groups.members));
+#endif
+#if (BTN_ENGINE == BTN_ENGINE_VERTICAL_COUNTER)
+	for(idx = 0; idx < kBtnVcSteps; ++idx)
+	{
+		struct sBtnVcStep *pstep = &pctx->vc.step[idx];
+		(void)memset(pstep->presswin, 0, sizeof(pstep->presswin));
+		(void)memset(pstep->releasewin, 0, sizeof(pstep->releasewin));
+		(void)memset(pstep->stuckwin, 0, sizeof(pstep->stuckwin));
+	}
+	pctx->vc.dbtimeout = ScansFor(pctx, kTmButtonDebounceTime, 1UL << kBtnVcTimerPlanes) - 1;
+#endif
+	for(idx = 0; idx < pctx->numbuttons; ++idx)
+	{
+		tBtnCalibration const *pcal = BtnCal(pctx, idx);
+		uint32_t w = idx / kBtnBitsPerWord;
+		tBtnPortWord mask = (tBtnPortWord)1 << (idx % kBtnBitsPerWord);
+
+		if(pcal->enabled && BtnWired(idx))
+		{
+			pctx->enabled[w] |= mask;
+#if (BTN_SCAN_GROUPS)
+			pctx->groups.members[GroupOf(pctx, idx)][w] |= mask;
+#endif
+		}
+#if (BTN_ENGINE == BTN_ENGINE_VERTICAL_COUNTER)
+		do {
+			uint32_t press		= ScansFor(pctx, pcal->tmPressDebounce, kBtnMaxDebounceSamples);
+			uint32_t release	= ScansFor(pctx, pcal->tmReleaseDebounce, kBtnMaxDebounceSamples);
+			uint32_t stuck		= ScansFor(pctx, pcal->tmStuck, 1UL << kBtnVcTimerPlanes) - 1;	// less one, as the state timer counts
+			struct sBtnVcStep *pstep = &pctx->vc.step[w / kBtnVcLaneWords];
+			uint32_t lane = w % kBtnVcLaneWords;
+			uint32_t plane;
+			for(plane = 0; plane < kBtnVcCountPlanes; ++plane)
+			{
+				if(press & (1UL << plane))		{ pstep->presswin[plane][lane] |= mask; }
+				if(release & (1UL << plane))	{ pstep->releasewin[plane][lane] |= mask; }
+			}
+			for(plane = 0; plane < kBtnVcTimerPlanes; ++plane)
+			{
+				if(stuck & (1UL << plane))		{ pstep->stuckwin[plane][lane] |= mask; }
+			}
+		} while(0);
+#endif
+	}
+	pctx->calapplied = true;
+}
+
+
+#if (BTN_ENGINE == BTN_ENGINE_SME)
+// ============================================================================
+// ----	Debounce Strategies ---------------------------------------------------
+// ============================================================================
+
+/** Number of set bits in a debounce shift register. */
+static uint32_t
+PopCount(uint32_t bits)
+{
+#if defined(__GNUC__)
+	return (uint32_t)__builtin_popcount(bits);
+#else
+	uint32_t count = 0;
+	for(; bits; bits &= bits - 1)	{ ++count; }
+	return count;
+#endif
+}
+
+static void
+DbShiftRegisterStart(tBtnCtx *pctx, uint32_t idx)
+{
+	UNUSED(pctx);
+	UNUSED(idx);		// the history alone decides
+}
+
+static tEvQ_EventID
+DbShiftRegisterSettled(tBtnCtx *pctx, uint32_t idx, uint32_t presswin, uint32_t releasewin)
+{
+	uint32_t pressmask = WindowMask(presswin);
+	if((pctx->btn.read_bits[idx] & WindowMask(releasewin)) == 0)	{ return evBtnReleased; }
+	if((pctx->btn.read_bits[idx] & pressmask) == pressmask)		{ return evBntPressed; }
+	return 0;
+}
+
+static void
+DbIntegratorStart(tBtnCtx *pctx, uint32_t idx)
+{
+	pctx->btn.dbcount[idx] = 0;
+}
+
+static tEvQ_EventID
+DbIntegratorSettled(tBtnCtx *pctx, uint32_t idx, uint32_t presswin, uint32_t releasewin)
+{
+	int32_t count = pctx->btn.dbcount[idx] + ((pctx->btn.read_bits[idx] & 1) ? 1 : -1);
+	pctx->btn.dbcount[idx] = (int8_t)count;
+	if(count >= (int32_t)presswin)		{ return evBntPressed; }
+	if(count <= -(int32_t)releasewin)	{ return evBtnReleased; }
+	return 0;
+}
+
+static void
+DbMajorityStart(tBtnCtx *pctx, uint32_t idx)
+{
+	pctx->btn.dbcount[idx] = 0;
+}
+
+static tEvQ_EventID
+DbMajoritySettled(tBtnCtx *pctx, uint32_t idx, uint32_t presswin, uint32_t releasewin)
+{
+	uint32_t taken = (uint32_t)pctx->btn.dbcount[idx];
+
+	// no verdict over a window until the window holds samples taken in this debounce.
+	if(taken < kBtnMaxDebounceSamples)	{ pctx->btn.dbcount[idx] = (int8_t)++taken; }
+	if((taken >= releasewin) && (PopCount(pctx->btn.read_bits[idx] & WindowMask(releasewin)) <= releasewin / 4))
+	{
+		return evBtnReleased;
+	}
+	if((taken >= presswin) && (PopCount(pctx->btn.read_bits[idx] & WindowMask(presswin)) >= presswin - (presswin / 4)))
+	{
+		return evBntPressed;
+	}
+	return 0;
+}
+
+#if !(BTN_SPECIALIZE)
+/** Debounce rules, indexed by #eBtnDebounceStrategy. */
+static tBtnDebouncer const tblDebouncers[kBtnNumDebounceStrategies] = {
+	/* kBtnDebounceShiftRegister	*/ { DbShiftRegisterStart,	DbShiftRegisterSettled	},
+	/* kBtnDebounceIntegrator		*/ { DbIntegratorStart,		DbIntegratorSettled		},
+	/* kBtnDebounceMajority			*/ { DbMajorityStart,		DbMajoritySettled		},
+};
+
+/** Debounce rule of one button; an unknown selection falls back to the shift register. */
+static tBtnDebouncer const *
+BtnDebouncer(tBtnCalibration const *pcal)
+{
+	return &tblDebouncers[(pcal->strategy < kBtnNumDebounceStrategies) ? pcal->strategy : kBtnDebounceShiftRegister];
+}
+#endif
+
+/** Start a debounce under the button's rule. */
+static void
+DebounceStart(tBtnCtx *pctx, tBtnCalibration const *pcal, uint32_t idx)
+{
+#if (BTN_SPECIALIZE)
+	switch(pcal->strategy)
+	{
+	case kBtnDebounceIntegrator:	DbIntegratorStart(pctx, idx);		break;
+	case kBtnDebounceMajority:		DbMajorityStart(pctx, idx);			break;
+	default:						DbShiftRegisterStart(pctx, idx);	break;
+	}
+#else
+	BtnDebouncer(pcal)->start(pctx, idx);
+#endif
+}
+
+/** Judge the latest sample under the button's rule; see tBtnDebouncer. */
+static tEvQ_EventID
+DebounceSettled(tBtnCtx *pctx, tBtnCalibration const *pcal, uint32_t idx, uint32_t presswin, uint32_t releasewin)
+{
+#if (BTN_SPECIALIZE)
+	switch(pcal->strategy)
+	{
+	case kBtnDebounceIntegrator:	return DbIntegratorSettled(pctx, idx, presswin, releasewin);
+	case kBtnDebounceMajority:		return DbMajoritySettled(pctx, idx, presswin, releasewin);
+	default:						return DbShiftRegisterSettled(pctx, idx, presswin, releasewin);
+	}
+#else
+	return BtnDebouncer(pcal)->settled(pctx, idx, presswin, releasewin);
+#endif
+}
+#endif	/* BTN_ENGINE_SME */
+
+
+// ============================================================================
+// ----	State Functions -------------------------------------------------------
+// ============================================================================
+
+#if (BTN_ENGINE == BTN_ENGINE_SME)
+
+/** Button-debounce state.
+ *	This routine is common for states when you're detecting a button push, and a release.
+ */
+static tStateReturnCodes
+stDebounceButton(tBtnCtx *pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	tBtnCalibration const *pcal;
+	uint32_t presswin, releasewin;
+	tEvQ_EventID settled;
+	uint32_t thisbutton;
+
+	if(!pev)	{return 0;}
+	if(!pextra)	{return 0;}
+
+	thisbutton = pev->evData;
+	switch(pctx->btn.statephase[thisbutton]++)
+	{
+	case kStateUninit:	/* on 1ste entry, execute on-entry action */
+	case kStateFinished:	/* upon return to this state after previous normal exit, execute on-entry action */
+	default:			/* for any unexpected value, restart this state. */
+		pctx->btn.evId[thisbutton] = pev->evId;				// save exit Reason1
+		pctx->btn.statephase[thisbutton] = kStateOperational;	// reinitialize state's phase marker unilaterally
+
+		/* for this task, we assume the transition was provoked by a non-zero bit on the most recent
+		 * DI bit read. seed our debounce var with that 1st bit.
+		 * NOTE: his line is legacy from early development. its effect is that it allows recognition
+		 * of a a switch press after 8 consecutive bits, but requires 10 consecutive bits to
+		 * recognize a switch release (the 1st 0 read is thrown away, then it needs another one to
+		 * "clear" this seeding of the initial 1).
+		 */
+		pctx->btn.read_bits[thisbutton] = 1;
+		pcal = BtnCal(pctx, thisbutton);
+		DebounceStart(pctx, pcal, thisbutton);
+#if (BTN_ADAPTIVE_DEBOUNCE)
+		presswin = SamplesFor(pctx, thisbutton, pcal->tmPressDebounce, kBtnMaxDebounceSamples);
+		releasewin = SamplesFor(pctx, thisbutton, pcal->tmReleaseDebounce, kBtnMaxDebounceSamples);
+		BtnAdaptStart(pctx, thisbutton, (presswin > releasewin) ? presswin : releasewin);
+#endif
+
+		// start my state timer. remember, our call rate is 10 ms. 100ms == 10 bit readings, 640ms is 64 bit reads
+		BtnTimerStart(pctx, thisbutton, kTmButtonDebounceTime);
+		break;
+
+	case kStateOperational:
+		// read next bit
+		pctx->btn.read_bits[thisbutton] <<= 1;				// shift current bits left one position
+		pctx->btn.read_bits[thisbutton] |= BtnInput(pctx, thisbutton);
+		// the button's calibrated windows, in scans, and its debounce rule decide when it has settled.
+		pcal = BtnCal(pctx, thisbutton);
+		presswin = SamplesFor(pctx, thisbutton, pcal->tmPressDebounce, kBtnMaxDebounceSamples);
+		releasewin = SamplesFor(pctx, thisbutton, pcal->tmReleaseDebounce, kBtnMaxDebounceSamples);
+#if (BTN_ADAPTIVE_DEBOUNCE)
+		BtnAdaptSample(pctx, thisbutton);
+		settled = DebounceSettled(pctx, pcal, thisbutton, BtnAdaptWindow(pctx, thisbutton, presswin), BtnAdaptWindow(pctx, thisbutton, releasewin));
+#else
+		settled = DebounceSettled(pctx, pcal, thisbutton, presswin, releasewin);
+#endif
+		if(settled)
+		{
+			// debounce done, recognized as a button press (advance to next state) or release
+			pctx->btn.evId[thisbutton] = settled;
+			pctx->btn.reason3[thisbutton] = kReasonDebounced;
+		}
+		else if(BtnTimerExpired(pctx, thisbutton))
+		{
+			pctx->btn.reason3[thisbutton] = kReasonTimeout;
+		}
+		else
+		{
+			--pctx->btn.statephase[thisbutton];		// nothing of note happened, stay in this state
+		}
+
+#if (BTN_ADAPTIVE_DEBOUNCE)
+		if(pctx->btn.statephase[thisbutton] == kStateExit)
+		{
+			if(pctx->btn.reason3[thisbutton] == kReasonDebounced)
+			{
+				BtnAdaptSettled(pctx, thisbutton, (presswin > releasewin) ? presswin : releasewin);
+			}
+			else
+			{
+				BtnAdaptUnsettled(pctx, thisbutton);
+			}
+		}
+#endif
+		break;
+
+	case kStateExit:
+		// the state timer is no longer needed.
+		BtnTimerStop(pctx, thisbutton);
+		//	let the caller (normally the SME) know what event and what guard provoked the change.
+		pev->evId = pctx->btn.evId[thisbutton];	// save exit reason 1 (event that provoked the exit)
+		pev->evData = thisbutton;		// save exit reason 2 (button recognized)
+		*pextra = pctx->btn.reason3[thisbutton];	// save exit reason 3 (reason for exit (no button, button, timeout)
+		break;
+	}
+
+	// the next line is part of the template and should not be touched.
+	return pctx->btn.statephase[thisbutton];
+}
+
+
+static tStateReturnCodes
+stStart(tBtnCtx *pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	uint32_t thisbutton;
+
+	if(!pev)	{ return 0; }
+	if(!pextra)	{ return 0; }
+
+	thisbutton = pev->evData;
+	switch(pctx->btn.statephase[thisbutton]++)
+	{
+	case kStateUninit:	/* on 1st entry, execute on-entry action */
+	case kStateFinished:	/* upon return to this state after previous normal exit, execute on-entry action */
+	default:			/* for any unexpected value, restart this state. */
+		// generic state management, common to all states
+		pctx->btn.statephase[thisbutton]	= kStateOperational;
+		pctx->btn.evId[thisbutton]		= pev->evId;			// save default exit reason 1.
+
+		// ---- state-specific behavior ---------
+		// no state-specific behavior for this state
+//		printf("Entering %s\n", __FUNCTION__);
+		break;
+
+	case kStateOperational:
+		// we'll basically leave as soon as we start.
+		break;
+
+	case kStateExit:
+		// manage the state machine: set exit reasons
+		pev->evId = pctx->btn.evId[thisbutton];	// exit reason 1: event that provoked the exit.
+		pev->evData = thisbutton;		// exit reason 2
+		*pextra = kReasonNone;			// exit reason 3 (for debugging use in transition)
+
+		// state-specific behavior
+		/* (no state-specific exit actions here) */
+//		printf("Leaving %s\n", __FUNCTION__);
+		break;
+	}
+
+	// the next line is part of the template and should not be touched.
+	return pctx->btn.statephase[thisbutton];
+}
+
+/**	Implement the Button Released state of the SM.
+
+ *	@note If return here is due to a stuck-button event, this state will continue to read a stream
+ *		  of "1" bits from the DI layer. In that case, there will be a continual cycle between this
+ *		  state, debounce-press, and pressed, then back here. \n
+ *		  The default SM has a special "stuck" state, which is intended to eliminate this cycle, but
+ *		  we wanted to describe the behavior if something should go wrong.
+ *	@{
+ */
+static tStateReturnCodes
+stButtonReleased(tBtnCtx *pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	uint32_t thisbutton;
+
+	if(!pev)	{return 0;}
+	if(!pextra)	{return 0;}
+
+	thisbutton = pev->evData;
+	switch(pctx->btn.statephase[thisbutton]++)
+	{
+	case kStateUninit:		/* on 1st entry, execute on-entry action */
+	case kStateFinished:	/* upon return to this state after previous normal exit, execute on-entry action */
+	default:				/* for any unexpected value, restart this state. */
+		// generic state management, common to all states
+		pctx->btn.statephase[thisbutton] = kStateOperational;	// reinitialize state's phase marker unilaterally
+
+		// ---- state-specific behavior ---------
+		// no state-specific behavior for this state
+//		printf("Entering %s\n", __FUNCTION__);
+		break;
+
+	case kStateOperational:
+		do {
+			// use local var so i can override it during debugging.
+			bool thisbit = BtnInput(pctx, thisbutton);	// issue #3: pass the current button
+			if(!thisbit)
+			{
+				// stay in this state until we see a twitch on one of the button inputs.
+				//	note: in this iteration of this implementation, we're only reading "button" 0
+				--pctx->btn.statephase[thisbutton];
+			}
+		} while(0);
+		break;
+
+	case kStateExit:
+		// manage the state machine: set exit reasons
+		// evId field (reason1) is OK as passed in.
+		pev->evData = thisbutton;		// reason2
+		*pextra = kReasonTwitchNoted;	// reason3
+
+		// state-specific behavior
+		/* (no state-specific exit actions here) */
+//		printf("Leaving %s\n", __FUNCTION__);
+		break;
+	}
+
+	// the next line is part of the template and should not be touched.
+	return pctx->btn.statephase[thisbutton];
+}
+/** @} */
+
+static tStateReturnCodes
+stDebouncePress(tBtnCtx *pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	return stDebounceButton(pctx, pev, pextra);
+}
+
+static tStateReturnCodes
+stButtonPressed(tBtnCtx *pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	uint32_t thisbutton;
+
+	if(!pev)	{return 0;}
+	if(!pextra)	{return 0;}
+
+	thisbutton = pev->evData;
+	switch(pctx->btn.statephase[thisbutton]++)
+	{
+	case kStateUninit:
+	case kStateFinished:
+	default:
+		pctx->btn.evId[thisbutton] = pev->evId;				// save exit Reason1
+		pctx->btn.reason3[thisbutton] = kReasonNone;			// save default exit Reason3
+		pctx->btn.statephase[thisbutton] = kStateOperational;	// reinitialize state's phase marker unilaterally
+
+		/* for this task, we stay here as long as the button remains pressed, or until the timeout
+		 * period expires. a "release" is seen as a zero bit on the bit input stream.
+		 */
+		BtnTimerStart(pctx, thisbutton, BtnCal(pctx, thisbutton)->tmStuck);
+//		printf("Entering %s\n", __FUNCTION__);
+		break;
+
+	case kStateOperational:
+		do {
+			bool thisbit;
+			// use local var so i can override it during debugging.
+			thisbit = BtnInput(pctx, thisbutton);
+			if(!thisbit)
+			{
+				// button might have been released, go to debounce-release state to confirm
+				pctx->btn.reason3[thisbutton] = kReasonTwitchNoted;
+			}
+			else if(BtnTimerExpired(pctx, thisbutton))
+			{
+				// we've been too long in the pressed-button state, there might be a stuck button
+				pctx->btn.reason3[thisbutton] = kReasonTimeout;
+			}
+			else
+			{
+				--pctx->btn.statephase[thisbutton];	// nothing of note happened, stay in this state
+			}
+		} while(0);
+		break;
+
+	case kStateExit:
+		// the state timer is no longer needed.
+		BtnTimerStop(pctx, thisbutton);
+		//	let the caller (normally the SME) know what event and what guard provoked the change.
+		pev->evId = pctx->btn.evId[thisbutton];		// save exit reason 1 (event that provoked the exit)
+		pev->evData = thisbutton;			// save exit reason 2 (button recognized)
+		*pextra = pctx->btn.reason3[thisbutton];		// save exit reason 3 (reason for exit (no button, button, timeout)
+//		printf("Leaving %s\n", __FUNCTION__);
+		break;
+	}
+
+	// the next line is part of the template and should not be touched.
+	return pctx->btn.statephase[thisbutton];
+}
+
+static tStateReturnCodes
+stDebounceRelease(tBtnCtx *pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	return stDebounceButton(pctx, pev, pextra);
+}
+
+static tStateReturnCodes
+stButtonStuck(tBtnCtx *pctx, ptEvQ_Event pev, uint32_t *pextra)
+{
+	uint32_t thisbutton;
+
+	if(!pev)	{return 0;}
+	if(!pextra)	{return 0;}
+
+	thisbutton = pev->evData;
+	switch(pctx->btn.statephase[thisbutton]++)
+	{
+	case kStateUninit:	/* on 1st entry, execute on-entry action */
+	case kStateFinished:	/* upon return to this state after previous normal exit, execute on-entry action */
+	default:			/* for any unexpected value, restart this state. */
+		pctx->btn.evId[thisbutton] = pev->evId;				// save exit Reason1
+		pctx->btn.statephase[thisbutton] = kStateOperational;	// reinitialize state's phase marker unilaterally
+//		printf("Entering %s\n", __FUNCTION__);
+		break;
+
+	case kStateOperational:
+		do {
+			bool thisbit = BtnInput(pctx, thisbutton);
+			if(thisbit)
+			{
+				// stay in this state as long as we read a "1" bit
+				--pctx->btn.statephase[thisbutton];
+			}
+		} while(0);
+		break;
+
+	case kStateExit:
+		// for this edition of this state, no state-specific exit action is required.
+		//	let the caller (normally the SME) know what event and what guard provoked the change.
+		pev->evId = pctx->btn.evId[thisbutton];	// save exit reason 1 (event that provoked the exit)
+
+		// there's one and only one reason we leave this state, no reason for supplying reasons.
+		//	However, to allow the transition action to make an informed decision, indicate a unique
+		//	exit code.
+		pev->evData = thisbutton;
+		*pextra = kReasonButtonUnstuck;
+//		printf("Leaving %s\n", __FUNCTION__);
+		break;
+	}
+
+	// the next line is part of the template and should not be touched.
+	return pctx->btn.statephase[thisbutton];
+}
+
+#endif	/* BTN_ENGINE_SME */
+
+
+// ============================================================================
+// ----	Transition Functions --------------------------------------------------
+// ============================================================================
+
+#if (BTN_ENGINE == BTN_ENGINE_SME)
+/** Do-nothing transition function.
+ *	This is entirely a debugging aid, it is not required by the transition table.
+ */
+static void
+NullTransition(tBtnCtx *pctx, tEvQ_Event ev, uint32_t extra)
+{
+	UNUSED(pctx);
+	UNUSED(ev);
+	UNUSED(extra);
+//	printf("Transition: ev: %i, Button: %i, Transition ID: %i\n", ev.evId, ev.evData, extra);
+}
+#endif
+
+#if !(BTN_VC_BATCH_DIRECT)
+/** Transition Function.
+ * 	This function notifies the world of a state change in our button-reading SM.
+ * 	Not sure it really matters to our design, if we post this event in the exit function vs. the
+ * 	transition; philosophically, it makes sense for the state to notify the world of its own status
+ * 	change, but actually (as realized in this implementation) it does not affect the timing of the
+ * 	event posting, in that both the exit action and the transition function are executed in the same
+ * 	instance of the SME. the one (small) factor that tilts me towards the transition function as the
+ * 	poster of note, is that philosophically, the exit action is supposed to be atomic and robust (as
+ * 	in, cannot fail), but in our system, the posting of an event can fail.
+ *
+ * 	we rely on the state providing the event detail to be posted.
+ */
+static void
+NotifyBtnStateChg(tBtnCtx *pctx, tEvQ_Event ev, uint32_t extra)
+{
+	switch(extra)
+	{
+	case kReasonDebounced:
+		// evId indicates button press or release
+		// evData indicates which button
+		// not much to do here except validate
+		switch(ev.evId)
+		{
+		case evBtnReleased:	// button has been released
+		case evBntPressed:	// state change to Pressed state
+			break;
+
+		default:
+			ev.evId = 0;
+			break;
+		}
+		break;
+
+	case kReasonTimeout:
+		ev.evId = evButton_BtnStuck;
+		break;
+
+	case kReasonButtonUnstuck:
+		ev.evId = evButton_BtnUnstuck;
+		break;
+
+	default:
+		ev.evId = 0;
+		break;
+	}
+#if (BTN_ENGINE == BTN_ENGINE_SME)
+	if(ev.evId)	{ StatesNote(pctx, ev); }
+#endif
+#if (BTN_CHORDS)
+	if(ev.evId && ChordFilter(pctx, ev))	{ ev.evId = 0; }
+#endif
+	if(ev.evId)
+	{
+		DeliverBtnEvent(pctx, ev);
+	}
+}
+#endif
+
+
+#if (BTN_ENGINE == BTN_ENGINE_SME)
+/// The transition table; rows in BTN_TRANSITIONS order, so a transition ID is its row.
+#define BTN_TRANSITION_ROW(cur, r1, r3, next, fn)	{ kBtnSt_##cur, BTN_EV_##r1, kReason##r3, kBtnSt_##next, fn },
+static tBtnTransition const tblTransitions[kBtnNumTransitions] = {
+	BTN_TRANSITIONS(BTN_TRANSITION_ROW)
+};
+
+/** Dense index of the transition table, keyed by (state, Reason1, Reason3).
+ *	Holds (row + 1) of the matching tblTransitions[] row; 0 marks "no transition".
+ */
+#define BTN_TRANSITION_KEY(cur, r1, r3, next, fn)	[kBtnSt_##cur][kBtnExEv_##r1][kReason##r3] = kBtnTr_##cur##_##r1##_##r3 + 1,
+static uint8_t const tblTransitionIndex[kBtnNumStates][kBtnNumExitEvents][kNumReasons] = {
+	BTN_TRANSITIONS(BTN_TRANSITION_KEY)
+};
+
+#if (BTN_SPECIALIZE)
+/// Direct calls in place of tblStates[] and the transition functions of tblTransitions[], for the
+///	compiler to inline.
+#define BTN_STATE_CALL(name)						case kBtnSt_##name:	rc = st##name(pctx, &ev, &extra);	break;
+#define BTN_TRANSITION_CALL(cur, r1, r3, next, fn)	case kBtnTr_##cur##_##r1##_##r3:	fn(pctx, ev, extra);	break;
+#else
+#define BTN_STATE_HANDLER(name)						st##name,
+static pfBtnStateHandler const tblStates[kBtnNumStates] = {
+	BTN_STATES(BTN_STATE_HANDLER)
+};
+#endif
+
+#if (BTN_PROFILE)
+/// Column names of the profile dump.
+/// @{
+#define BTN_STATE_NAME(name)						"st:" #name,
+static char const * const tblStateNames[kBtnNumStates] = {
+	BTN_STATES(BTN_STATE_NAME)
+};
+
+#define BTN_TRANSITION_NAME(cur, r1, r3, next, fn)	"tr:" #cur "/" #r1 "/" #r3 ">" #next,
+static char const * const tblTransitionNames[kBtnNumTransitions] = {
+	BTN_TRANSITIONS(BTN_TRANSITION_NAME)
+};
+/// @}
+#endif
+
+
+// ============================================================================
+// ----	State Machine Engine --------------------------------------------------
+// ============================================================================
+
+#if (BTN_LATENCY_STATS)
+/** Track edge-to-event latency across one transition of a button's SM.
+ *	A state's exit runs at the button's next sample after the one that decided it, so the edge was
+ *	seen, and the event decided, one sample before the transition; the event itself is posted by the
+ *	transition.
+ *	@param[in]	idx		Button ID.
+ *	@param[in]	tr		Transition taken (#eBtnTransitions).
+ */
+static void
+BtnLatencyNote(tBtnCtx *pctx, uint32_t idx, uint32_t tr)
+{
+	uint32_t scans;
+
+	switch(tr)
+	{
+	case kBtnTr_ButtonReleased_Task_TwitchNoted:
+	case kBtnTr_ButtonPressed_Task_TwitchNoted:
+		// a debounce that timed out starts over straight away; its first edge still counts.
+		if(!pctx->latency.armed[idx])
+		{
+			pctx->latency.edgescan[idx] = pctx->scancount - SampleEvery(pctx, idx);
+			pctx->latency.armed[idx] = 1;
+		}
+		break;
+
+	case kBtnTr_DebouncePress_Pressed_Debounced:
+	case kBtnTr_DebounceRelease_Released_Debounced:
+		if(pctx->latency.armed[idx])
+		{
+			scans = pctx->scancount - pctx->latency.edgescan[idx];
+			++pctx->latency.hist[idx][LatBucket(scans)];
+			++pctx->latency.count[idx];
+			if(scans > pctx->latency.max[idx])	{ pctx->latency.max[idx] = scans; }
+		}
+		pctx->latency.armed[idx] = 0;
+		break;
+
+	case kBtnTr_DebouncePress_Released_Debounced:
+	case kBtnTr_DebounceRelease_Pressed_Debounced:
+		// the input settled back where it was; that was a glitch, not an edge.
+		pctx->latency.armed[idx] = 0;
+		break;
+
+	default:
+		break;
+	}
+}
+#endif
+
+#if (BTN_PROFILE)
+/** Count one transition of a button's SM, and charge the state it leaves w/ the time spent there.
+ *	@param[in]	idx		Button ID.
+ *	@param[in]	state	State being left.
+ *	@param[in]	tr		Transition taken (#eBtnTransitions).
+ */
+static void
+BtnProfileNote(tBtnCtx *pctx, uint32_t idx, uint8_t state, uint32_t tr)
+{
+	++pctx->profile.transitions[idx][tr];
+	pctx->profile.dwell[idx][state] += pctx->scancount - pctx->profile.entered[idx];
+	pctx->profile.entered[idx] = pctx->scancount;
+}
+
+/** Write one unsigned value, preceded by `sep`, for the profile dump. */
+static void
+ProfileOutU32(pfBtnTextOut pfout, char const *sep, uint32_t value)
+{
+	char text[11];
+	char *pdigit = &text[sizeof(text) - 1];
+
+	*pdigit = '\0';
+	do {
+		*--pdigit = (char)('0' + (value % 10));
+		value /= 10;
+	} while(value);
+	pfout(sep);
+	pfout(pdigit);
+}
+#endif
+
+/** Run one step of one button's SM.
+ *	Equivalent to Cwsw_Sme__SME() for this module's SM, except that when a state finishes, its
+ *	transition is found with one indexed load from tblTransitionIndex[] rather than by scanning the
+ *	transition table.
+ *	@returns the button's next state, or #kBtnNumStates if the finished state has no transition.
+ */
+static uint8_t
+BtnSme(tBtnCtx *pctx, uint8_t state, tEvQ_Event ev, uint32_t extra)
+{
+	uint32_t exitev;
+	uint8_t row = 0;
+
+#if (BTN_SPECIALIZE)
+	tStateReturnCodes rc;
+	switch(state)
+	{
+	BTN_STATES(BTN_STATE_CALL)
+	default:	return kBtnNumStates;
+	}
+	if(rc != kStateFinished)	{ return state; }
+#else
+	if(tblStates[state](pctx, &ev, &extra) != kStateFinished)	{ return state; }
+#endif
+
+	switch(ev.evId)
+	{
+	case BTN_EV_Task:		exitev = kBtnExEv_Task;		break;
+	case BTN_EV_Pressed:	exitev = kBtnExEv_Pressed;	break;
+	case BTN_EV_Released:	exitev = kBtnExEv_Released;	break;
+	default:				exitev = kBtnNumExitEvents;	break;
+	}
+	if((exitev < kBtnNumExitEvents) && (extra < kNumReasons))
+	{
+		row = tblTransitionIndex[state][exitev][extra];
+	}
+	if(!row)	{ return kBtnNumStates; }
+
+#if (BTN_SCAN_THREADS)
+	// other shards may be scanning on other threads; the transition runs once the scan is joined.
+	if(tblTransitions[row - 1].transition != NullTransition)
+	{
+		struct sBtnShardLog *plog = &pctx->shardlog[ev.evData / kBtnShardButtons];
+		plog->entry[plog->count++] = (ev.evData << 8) | (row - 1u);
+	}
+#elif (BTN_SPECIALIZE)
+	switch(row - 1u)
+	{
+	BTN_TRANSITIONS(BTN_TRANSITION_CALL)
+	default:	break;
+	}
+#else
+	tblTransitions[row - 1].transition(pctx, ev, extra);
+#endif
+#if (BTN_LATENCY_STATS)
+	BtnLatencyNote(pctx, ev.evData, row - 1u);
+#endif
+#if (BTN_PROFILE)
+	BtnProfileNote(pctx, ev.evData, state, row - 1u);
+#endif
+	return tblTransitions[row - 1].next;
+}
+
+/** Step one button's SM, and note whether the scans to come may skip it. */
+static void
+StepButton(tBtnCtx *pctx, uint32_t idxbutton, tEvQ_Event ev, uint32_t extra)
+{
+	uint32_t idxword = idxbutton / kBtnBitsPerWord;
+	tBtnPortWord mask = (tBtnPortWord)1 << (idxbutton % kBtnBitsPerWord);
+
+	ev.evData = idxbutton;
+	pctx->btn.currentstate[idxbutton] = BtnSme(pctx, pctx->btn.currentstate[idxbutton], ev, extra);
+
+	if(pctx->btn.currentstate[idxbutton] >= kBtnNumStates)
+	{
+		// disable alarm that launches this SME via its event.
+		//	if restarted, this button's SM restarts w/ the init state.
+		pctx->btn.currentstate[idxbutton] = kBtnSt_Start;
+		BtnTimerStop(pctx, idxbutton);
+#if (BTN_SCAN_THREADS)
+		pctx->shardlog[idxbutton / kBtnShardButtons].fault = true;
+#else
+		pctx->ptmr->tmrstate = kTmrState_Disabled;
+#endif
+	}
+
+	pctx->btn.quiet[idxword] &= ~mask;
+	pctx->btn.held[idxword] &= ~mask;
+	if(pctx->btn.statephase[idxbutton] == kStateOperational)
+	{
+		switch(pctx->btn.currentstate[idxbutton])
+		{
+		case kBtnSt_ButtonReleased:	pctx->btn.quiet[idxword] |= mask;	break;
+		case kBtnSt_ButtonPressed:
+		case kBtnSt_ButtonStuck:	pctx->btn.held[idxword] |= mask;	break;
+		default:					break;
+		}
+	}
+}
+
+/** Scan one shard: advance its timers, then step the SM of every button that needs it, from the top
+ *	down.
+ */
+static void
+ScanShard(tBtnCtx *pctx, uint32_t shard, tEvQ_Event ev, uint32_t extra)
+{
+	uint32_t first = shard * kBtnShardWords;
+	uint32_t idxword = first + kBtnShardWords;
+
+	if(idxword > kBtnNumPortWords)	{ idxword = kBtnNumPortWords; }
+#if (BTN_COMPACT)
+	TimersRun(pctx, shard);
+#else
+	WheelRun(pctx, shard);
+#endif
+	while(idxword-- > first)
+	{
+		// skip buttons idle in "released" w/ an open input, buttons held in "pressed" or "stuck" w/ a
+		//	closed input and a running timer, and disabled buttons; a fully idle port word costs a
+		//	handful of logic operations.
+		tBtnPortWord quiet = pctx->btn.quiet[idxword], held = pctx->btn.held[idxword], in = pctx->inputs[idxword];
+#if (BTN_SCAN_GROUPS)
+		tBtnPortWord pending = (~(quiet | held) | (quiet & in) | (held & ~in) | pctx->btn.expired[idxword]) & pctx->groups.due[idxword];
+#else
+		tBtnPortWord pending = (~(quiet | held) | (quiet & in) | (held & ~in) | pctx->btn.expired[idxword]) & pctx->enabled[idxword];
+#endif
+
+#if (BTN_SPECIALIZE)
+		// one port word: a test per wired button, and nothing at all for the rest.
+#define BTN_SCAN_BIT(n)		if((((tBtnPortWord)(BTN_WIRED_MASK) >> (n)) & 1) && ((n) < kBoardNumButtons) && ((pending >> (n)) & 1))	{ StepButton(pctx, (n), ev, extra); }
+		BTN_SCAN_BITS(BTN_SCAN_BIT)
+#undef BTN_SCAN_BIT
+#else
+		while(pending)
+		{
+			uint32_t bit = HighestBit(pending);
+			pending &= ~((tBtnPortWord)1 << bit);
+			StepButton(pctx, (idxword * kBtnBitsPerWord) + bit, ev, extra);
+		}	// button
+#endif
+	}	// port word
+}
+
+#if (BTN_SCAN_THREADS)
+/** Take the next shard for one participant in the scan: the bottom of its own range, or failing that,
+ *	the top of another's.
+ *	@returns false once no shard is left anywhere.
+ */
+static bool
+ShardTake(tBtnCtx *pctx, uint32_t self, uint32_t *pshard)
+{
+	uint32_t n;
+
+	for(n = 0; n <= BTN_SCAN_THREADS; ++n)
+	{
+		uint32_t victim = (self + n) % (BTN_SCAN_THREADS + 1);
+		_Atomic uint64_t *prange = &pctx->workers.queue[victim].range;
+		uint64_t range = atomic_load(prange);
+		uint64_t lo = range & UINT32_MAX, hi = range >> 32;
+
+		while(lo < hi)
+		{
+			uint64_t taken = (victim == self) ? lo : (hi - 1);
+			uint64_t left = (victim == self) ? (range + 1) : (lo | ((hi - 1) << 32));
+			if(atomic_compare_exchange_weak(prange, &range, left))
+			{
+				*pshard = (uint32_t)taken;
+				return true;
+			}
+			lo = range & UINT32_MAX;
+			hi = range >> 32;
+		}
+	}
+	return false;
+}
+
+/** Scan shards until none is left. */
+static void
+WorkerRun(tBtnCtx *pctx, uint32_t self)
+{
+	uint32_t shard;
+	while(ShardTake(pctx, self, &shard))
+	{
+		ScanShard(pctx, shard, pctx->workers.ev, pctx->workers.extra);
+	}
+}
+
+/** Worker thread: join in each scan of its instance. */
+static void *
+BtnWorker(void *parg)
+{
+	struct sBtnShardQueue const *pqueue = (struct sBtnShardQueue const *)parg;
+	struct sBtnWorkers *pw = &pqueue->pctx->workers;
+	uint32_t seen = 0;
+
+	for(;;)
+	{
+		(void)pthread_mutex_lock(&pw->lock);
+		while(pw->generation == seen)	{ (void)pthread_cond_wait(&pw->start, &pw->lock); }
+		seen = pw->generation;
+		(void)pthread_mutex_unlock(&pw->lock);
+
+		WorkerRun(pqueue->pctx, pqueue->self);
+
+		(void)pthread_mutex_lock(&pw->lock);
+		++pw->idle;
+		(void)pthread_cond_signal(&pw->done);
+		(void)pthread_mutex_unlock(&pw->lock);
+	}
+	return NULL;
+}
+
+/** Start the instance's workers. Those that fail to start are done without; w/ none, the calling
+ *	thread scans every shard itself.
+ */
+static void
+WorkersStart(tBtnCtx *pctx)
+{
+	struct sBtnWorkers *pw = &pctx->workers;
+	pthread_t thread;
+	uint32_t n;
+
+	pw->started = true;
+	for(n = 0; n <= BTN_SCAN_THREADS; ++n)
+	{
+		pw->queue[n].pctx = pctx;
+		pw->queue[n].self = n;
+	}
+	if(pthread_mutex_init(&pw->lock, NULL))		{ return; }
+	if(pthread_cond_init(&pw->start, NULL))		{ return; }
+	if(pthread_cond_init(&pw->done, NULL))		{ return; }
+	for(n = 1; n <= BTN_SCAN_THREADS; ++n)
+	{
+		if(pthread_create(&thread, NULL, BtnWorker, &pw->queue[n]))	{ break; }
+		(void)pthread_detach(thread);
+		++pw->nthreads;
+	}
+}
+
+/** Run the transitions the shards deferred, in the order a single-threaded scan would have run them. */
+static void
+ShardMerge(tBtnCtx *pctx, tEvQ_Event ev)
+{
+	uint32_t shard = kBtnNumShards;
+	uint32_t n;
+
+	while(shard--)
+	{
+		struct sBtnShardLog *plog = &pctx->shardlog[shard];
+		for(n = 0; n < plog->count; ++n)
+		{
+			tBtnTransition const *ptr = &tblTransitions[plog->entry[n] & 0xFF];
+			ev.evId = ptr->reason1;
+			ev.evData = plog->entry[n] >> 8;
+			ptr->transition(pctx, ev, ptr->reason3);
+		}
+		plog->count = 0;
+		if(plog->fault)
+		{
+			plog->fault = false;
+			pctx->ptmr->tmrstate = kTmrState_Disabled;
+		}
+	}
+}
+#endif
+
+/** Scan every shard; w/ worker threads, share them out and wait for all to finish. */
+static void
+ScanShards(tBtnCtx *pctx, tEvQ_Event ev, uint32_t extra)
+{
+#if (BTN_SCAN_THREADS)
+	struct sBtnWorkers *pw = &pctx->workers;
+	uint64_t lo, hi;
+	uint32_t n;
+
+	if(!pw->started)	{ WorkersStart(pctx); }
+
+	// deal the shards out in contiguous ranges, one per participant.
+	for(n = 0; n <= pw->nthreads; ++n)
+	{
+		lo = ((uint64_t)n * kBtnNumShards) / (pw->nthreads + 1);
+		hi = ((uint64_t)(n + 1) * kBtnNumShards) / (pw->nthreads + 1);
+		atomic_store(&pw->queue[n].range, lo | (hi << 32));
+	}
+	pw->ev = ev;
+	pw->extra = extra;
+
+	if(pw->nthreads)
+	{
+		(void)pthread_mutex_lock(&pw->lock);
+		++pw->generation;
+		pw->idle = 0;
+		(void)pthread_cond_broadcast(&pw->start);
+		(void)pthread_mutex_unlock(&pw->lock);
+	}
+	WorkerRun(pctx, 0);
+	if(pw->nthreads)
+	{
+		(void)pthread_mutex_lock(&pw->lock);
+		while(pw->idle < pw->nthreads)	{ (void)pthread_cond_wait(&pw->done, &pw->lock); }
+		(void)pthread_mutex_unlock(&pw->lock);
+	}
+	ShardMerge(pctx, ev);
+
+#else
+	uint32_t shard = kBtnNumShards;
+	while(shard--)	{ ScanShard(pctx, shard, ev, extra); }
+#endif
+}
+#endif
+
+
+#if (BTN_ENGINE == BTN_ENGINE_VERTICAL_COUNTER)
+// ============================================================================
+// ----	Vertical-Counter Engine -----------------------------------------------
+// ============================================================================
+
+/* the vertical-counter engine is the per-button SME, bit-sliced: each button's state, phase, debounce
+ * history and state timer are bits in port-word planes, and one pass of logic operations steps the
+ * SMEs of every button in a port word. it keeps the SME's timing exactly, so both post the same
+ * events on the same scans:
+ * - a state's entry and exit phases each take a scan in which no input is read; the event of a
+ *   transition is posted by the exit phase, on the scan after the one that decided it.
+ * - a debounce starts seeded w/ one "pressed" sample, as the SME's shift register is; a press
+ *   settles once the latest press-window samples, counting the seed, are all 1, and a release once
+ *   the latest release-window samples are all 0. a debounce that hasn't settled by the debounce
+ *   timeout gives up, returning to the state it came from.
+ * - a button held for its stuck timeout is reported stuck; the first open sample then reports it
+ *   unstuck and returns it directly to "released" without a release event.
+ * - a button disabled by its calibration is frozen, but its state timer runs on.
+ * only the shift-register debounce rule is available; the calibration's strategy is ignored.
+ */
+
+/** Load one step of the engine's own words. */
+static tBtnVcLanes
+VcLoad(tBtnPortWord const *pwords)
+{
+	tBtnVcLanes v;
+	(void)memcpy(&v, pwords, sizeof(v));
+	return v;
+}
+
+/** Store one step of the engine's own words. */
+static void
+VcStore(tBtnPortWord *pwords, tBtnVcLanes v)
+{
+	(void)memcpy(pwords, &v, sizeof(v));
+}
+
+/** Some button of the step is flagged. */
+static bool
+VcAny(tBtnVcLanes v)
+{
+	tBtnPortWord words[kBtnVcLaneWords], any = 0;
+	uint32_t i;
+	(void)memcpy(words, &v, sizeof(words));
+	for(i = 0; i < kBtnVcLaneWords; ++i)	{ any |= words[i]; }
+	return any != 0;
+}
+
+/** Buttons whose counter is at or past their limit; both bit-sliced, `planes` deep. */
+static tBtnVcLanes
+VcAtLeast(tBtnVcLanes const pcount[], tBtnVcLanes const plimit[], uint32_t planes)
+{
+	tBtnVcLanes gt = {0}, eq = ~gt;
+	while(planes--)
+	{
+		gt |= eq & pcount[planes] & ~plimit[planes];
+		eq &= ~(pcount[planes] ^ plimit[planes]);
+	}
+	return gt | eq;
+}
+
+/** Step the SMEs of one step of port words.
+ *	@param[in]	s			Step.
+ *	@param[out]	edge		Events the exit phases post this scan, one edge word each (#eBtnVcEdges).
+ */
+static void
+VcStep(tBtnCtx *pctx, uint32_t s, tBtnVcLanes edge[kBtnVcNumEdges])
+{
+	struct sBtnVcStep *pvc = &pctx->vc.step[s];
+	uint32_t w = s * kBtnVcLaneWords;
+	tBtnVcLanes st[kBtnVcNumStates], pend[kBtnVcNumEdges];
+	tBtnVcLanes run[kBtnVcCountPlanes], limit[kBtnVcCountPlanes];
+	tBtnVcLanes x = VcLoad(&pctx->inputs[w]), en = VcLoad(&pctx->enabled[w]);
+	tBtnVcLanes oper = VcLoad(pvc->oper), leave, last, debounced, stuck;
+	tBtnVcLanes entering, leaving, operating, debouncing, indebounce, timed, instate, carry, reset, settled, expired;
+	tBtnVcLanes setpress, setrelease, toreleased, todebpress, topressed, todebrelease, tostuck, decided;
+	uint32_t i;
+
+	for(i = 0; i < kBtnVcNumStates; ++i)	{ st[i] = VcLoad(pvc->state[i]); }
+
+	// most scans, every button is released and open (or stuck and closed), and no state timer is
+	//	running: nothing changes.
+	indebounce	= st[kBtnVcDebouncePress] | st[kBtnVcDebounceRelease];
+	timed		= indebounce | st[kBtnVcPressed];
+	if(!VcAny((~(oper & ((st[kBtnVcReleased] & ~x) | (st[kBtnVcStuck] & x))) & en) | timed))
+	{
+		for(i = 0; i < kBtnVcNumEdges; ++i)	{ edge[i] = (tBtnVcLanes){0}; }
+		return;
+	}
+
+	leave		= VcLoad(pvc->leave);
+	last		= VcLoad(pvc->last);
+	debounced	= VcLoad(&pctx->vc.debounced[w]);
+	stuck		= VcLoad(&pctx->vc.stuck[w]);
+	for(i = 0; i < kBtnVcNumEdges; ++i)		{ pend[i] = VcLoad(pvc->pend[i]); }
+
+	// each enabled button is in one phase of its state; a disabled one stays where it is.
+	leaving		= leave & en;
+	entering	= ~(oper | leave) & en;
+	operating	= oper & en;
+
+	// exit phase: post the event decided last scan; the new state's entry is next scan.
+	for(i = 0; i < kBtnVcNumEdges; ++i)
+	{
+		edge[i] = pend[i] & leaving;
+		pend[i] &= ~leaving;
+	}
+	debounced	= (debounced | edge[kBtnVcEdgePressed]) & ~(edge[kBtnVcEdgeReleased] | edge[kBtnVcEdgeUnstuck]);
+	stuck		= (stuck | edge[kBtnVcEdgeStuck]) & ~edge[kBtnVcEdgeUnstuck];
+	leave &= ~leaving;
+
+	// entry starts the state timer at its timeout, less one; as the SME's timer keeps its deadline,
+	//	this one keeps the timeout it started with.
+	expired = VcLoad(pvc->expired);
+	if(VcAny(entering))
+	{
+		for(i = 0; i < kBtnVcTimerPlanes; ++i)
+		{
+			tBtnVcLanes dbbit = {0};
+			if(pctx->vc.dbtimeout & (1UL << i))	{ dbbit = ~dbbit; }
+			VcStore(pvc->left[i], (VcLoad(pvc->left[i]) & ~entering)
+					| (entering & ((indebounce & dbbit) | (~indebounce & VcLoad(pvc->stuckwin[i])))));
+		}
+		expired &= ~entering;
+	}
+
+	// the timer counts down, enabled or not, in the states that use it. the borrow out of its top
+	//	plane expires it, and stops it; most scans, the borrow ends within a plane or two.
+	carry = timed & ~expired & ~entering;
+	for(i = 0; (i < kBtnVcTimerPlanes) && VcAny(carry); ++i)
+	{
+		tBtnVcLanes l = VcLoad(pvc->left[i]);
+		VcStore(pvc->left[i], l ^ carry);
+		carry &= ~l;
+	}
+	expired |= carry;
+	VcStore(pvc->expired, expired);
+
+	// entry phase: seed the debounce w/ one "pressed" sample. operational phase: a debounce counts
+	//	the run of equal samples, up to the latest.
+	oper |= entering;
+	debouncing	= operating & indebounce;
+	setpress	= (tBtnVcLanes){0};
+	setrelease	= setpress;
+	if(VcAny(debouncing | entering))
+	{
+		carry	= debouncing & ~(x ^ last);
+		reset	= (debouncing & (x ^ last)) | entering;
+		for(i = 0; i < kBtnVcCountPlanes; ++i)
+		{
+			tBtnVcLanes r = VcLoad(pvc->run[i]);
+			run[i] = ((r ^ carry) & ~reset) | ((i == 0) ? reset : (tBtnVcLanes){0});
+			carry &= r;
+			VcStore(pvc->run[i], run[i]);
+		}
+		last = (last & ~debouncing) | (x & debouncing) | entering;
+
+		for(i = 0; i < kBtnVcCountPlanes; ++i)
+		{
+			limit[i] = (last & VcLoad(pvc->presswin[i])) | (~last & VcLoad(pvc->releasewin[i]));
+		}
+		settled		= VcAtLeast(run, limit, kBtnVcCountPlanes);
+		setpress	= debouncing & last & settled;
+		setrelease	= debouncing & ~last & settled;
+	}
+
+	// the transition table.
+	instate			= st[kBtnVcReleased] | st[kBtnVcDebouncePress] | st[kBtnVcPressed] | st[kBtnVcDebounceRelease] | st[kBtnVcStuck];
+	todebpress		= operating & st[kBtnVcReleased] & x;
+	topressed		= operating & ((st[kBtnVcDebouncePress] & setpress) | (st[kBtnVcDebounceRelease] & ~setrelease & (setpress | expired)));
+	todebrelease	= operating & st[kBtnVcPressed] & ~x;
+	tostuck			= operating & st[kBtnVcPressed] & x & expired;
+	toreleased		= operating & (~instate
+						| (st[kBtnVcDebouncePress] & ~setpress & (setrelease | expired))
+						| (st[kBtnVcDebounceRelease] & setrelease)
+						| (st[kBtnVcStuck] & ~x));
+	decided			= toreleased | todebpress | topressed | todebrelease | tostuck;
+
+	pend[kBtnVcEdgePressed]		|= topressed & st[kBtnVcDebouncePress];
+	pend[kBtnVcEdgeReleased]	|= toreleased & st[kBtnVcDebounceRelease];
+	pend[kBtnVcEdgeStuck]		|= tostuck;
+	pend[kBtnVcEdgeUnstuck]		|= toreleased & st[kBtnVcStuck];
+
+	st[kBtnVcReleased]			= (st[kBtnVcReleased] & ~decided) | toreleased;
+	st[kBtnVcDebouncePress]		= (st[kBtnVcDebouncePress] & ~decided) | todebpress;
+	st[kBtnVcPressed]			= (st[kBtnVcPressed] & ~decided) | topressed;
+	st[kBtnVcDebounceRelease]	= (st[kBtnVcDebounceRelease] & ~decided) | todebrelease;
+	st[kBtnVcStuck]				= (st[kBtnVcStuck] & ~decided) | tostuck;
+	oper	&= ~decided;
+	leave	|= decided;
+
+	for(i = 0; i < kBtnVcNumStates; ++i)	{ VcStore(pvc->state[i], st[i]); }
+	for(i = 0; i < kBtnVcNumEdges; ++i)		{ VcStore(pvc->pend[i], pend[i]); }
+	VcStore(pvc->oper, oper);
+	VcStore(pvc->leave, leave);
+	VcStore(pvc->last, last);
+	VcStore(&pctx->vc.debounced[w], debounced);
+	VcStore(&pctx->vc.stuck[w], stuck);
+}
+
+/** Post the events of one step's edges, highest button first.
+ *	@param[in]	s			Step.
+ *	@param[in]	edge		The step's edge words, from VcStep().
+ */
+static void
+VcPostEdges(tBtnCtx *pctx, tEvQ_Event ev, uint32_t s, tBtnVcLanes const edge[kBtnVcNumEdges])
+{
+	tBtnPortWord pedge[kBtnVcNumEdges][kBtnVcLaneWords];
+	uint32_t lane = kBtnVcLaneWords, e;
+#if (BTN_VC_BATCH_DIRECT)
+	tBtnBatch *pbatch = &pctx->batchlog.slot[pctx->batchlog.cur];
+	UNUSED(ev);
+#endif
+
+	for(e = 0; e < kBtnVcNumEdges; ++e)	{ VcStore(pedge[e], edge[e]); }
+	while(lane--)
+	{
+		uint32_t w = (s * kBtnVcLaneWords) + lane;
+#if (BTN_VC_BATCH_DIRECT)
+		// the edge words are already in batch form.
+		if(w >= kBtnNumPortWords)	{ continue; }
+		pbatch->pressed[w]	|= pedge[kBtnVcEdgePressed][lane];
+		pbatch->released[w]	|= pedge[kBtnVcEdgeReleased][lane];
+		pbatch->stuck[w]	|= pedge[kBtnVcEdgeStuck][lane];
+		pbatch->unstuck[w]	|= pedge[kBtnVcEdgeUnstuck][lane];
+		pctx->batchlog.pending = true;
+#else
+		tBtnPortWord pending = pedge[kBtnVcEdgePressed][lane] | pedge[kBtnVcEdgeReleased][lane] | pedge[kBtnVcEdgeStuck][lane] | pedge[kBtnVcEdgeUnstuck][lane];
+		while(pending)
+		{
+			uint32_t bit = HighestBit(pending);
+			tBtnPortWord mask = (tBtnPortWord)1 << bit;
+			pending &= ~mask;
+
+			ev.evData = (w * kBtnBitsPerWord) + bit;
+			if(pedge[kBtnVcEdgePressed][lane] & mask)	{ ev.evId = evBntPressed;	NotifyBtnStateChg(pctx, ev, kReasonDebounced); }
+			if(pedge[kBtnVcEdgeReleased][lane] & mask)	{ ev.evId = evBtnReleased;	NotifyBtnStateChg(pctx, ev, kReasonDebounced); }
+			if(pedge[kBtnVcEdgeStuck][lane] & mask)		{ NotifyBtnStateChg(pctx, ev, kReasonTimeout); }
+			if(pedge[kBtnVcEdgeUnstuck][lane] & mask)	{ NotifyBtnStateChg(pctx, ev, kReasonButtonUnstuck); }
+		}
+#endif
+	}
+}
+
+/** One scan of the vertical-counter engine: step the SMEs from the top down, posting each step's
+ *	events as it goes; the same order in which the SME engine visits the per-button SMEs, and
+ *	through the same transition function.
+ */
+static void
+VcScan(tBtnCtx *pctx, tEvQ_Event ev)
+{
+	tBtnVcLanes edge[kBtnVcNumEdges];
+	uint32_t s = kBtnVcSteps;
+
+	ReadInputs(pctx);
+	while(s--)
+	{
+		VcStep(pctx, s, edge);
+		if(VcAny(edge[kBtnVcEdgePressed] | edge[kBtnVcEdgeReleased] | edge[kBtnVcEdgeStuck] | edge[kBtnVcEdgeUnstuck]))
+		{
+			VcPostEdges(pctx, ev, s, edge);
+		}
+	}
+}
+#endif	/* BTN_ENGINE_VERTICAL_COUNTER */
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+#if (BTN_INSTANCES)
+ptBtnCtx
+Btn_CtxCreate(uint32_t numbuttons)
+{
+	tBtnCtx *pctx;
+
+	if(!numbuttons || (numbuttons > kBoardNumButtons))	{ return NULL; }
+	if(btnpoolused >= BTN_INSTANCES)					{ return NULL; }
+
+	pctx = &btnpool[btnpoolused++];
+	(void)memset(pctx, 0, sizeof(*pctx));
+	pctx->ptmr				= &pctx->tmr;
+	pctx->numbuttons		= numbuttons;
+	pctx->tmr.tm			= tmr10ms;
+	pctx->tmr.reloadtm		= tmr10ms;
+	pctx->tmr.tmrstate		= kTmrState_Enabled;
+	return pctx;
+}
+#endif
+
+ptBtnCtx
+Btn_GetDefaultCtx(void)
+{
+	return &btndefault;
+}
+
+tCwswSwAlarm *
+Btn_CtxAlarm(ptBtnCtx pctx)
+{
+	return pctx ? pctx->ptmr : NULL;
+}
+
+/** Button handler.
+ *	This version is specifically tied to the GTK board. It is a prime candidate for refactoring once
+ *	we add support for more boards.
+ *
+ *	This handler needs to make the adaptation between our array of button state machines (one SM for
+ *	each button), and the single-instance SME.
+ *
+ *	When built with #BTN_ENGINE set to #BTN_ENGINE_VERTICAL_COUNTER, the per-button SMEs are replaced
+ *	by bit-sliced vertical counters that debounce a whole port word per pass; the events posted are
+ *	the same.
+ */
+void
+Btn_CtxButtonRead(ptBtnCtx pctx, tEvQ_Event ev, uint32_t extra)
+{
+	if(!pctx)	{ return; }
+	if(!pctx->calapplied)	{ ApplyCalibration(pctx); }
+	++pctx->scancount;
+
+#if (BTN_ENGINE == BTN_ENGINE_VERTICAL_COUNTER)
+	UNUSED(extra);
+	VcScan(pctx, ev);
+
+#else
+#if (BTN_SCAN_GROUPS)
+	GroupsDue(pctx);
+#endif
+	ReadInputs(pctx);
+	ScanShards(pctx, ev, extra);
+#endif
+
+#if (BTN_CHORDS)
+	ChordScan(pctx, ev);
+#endif
+#if (BTN_GESTURES)
+	GestureScan(pctx, ev);
+#endif
+#if (BTN_BATCH_EVENTS)
+	BatchPost(pctx, ev);
+#endif
+	StatesPublish(pctx);
+}
+
+
+void
+Btn_CtxSetCalibration(ptBtnCtx pctx, tBtnCalibration const *pcal)
+{
+	if(!pctx)	{ return; }
+	pctx->pcaltable = pcal;
+	ApplyCalibration(pctx);
+}
+
+bool
+Btn_CtxSetCalibrationImage(ptBtnCtx pctx, void const *pimage, size_t size)
+{
+	tBtnCalImageHdr const *phdr = (tBtnCalImageHdr const *)pimage;
+
+	if(!pctx || !pimage || (size < sizeof(tBtnCalImageHdr)))	{ return false; }
+	if(((uintptr_t)pimage % sizeof(uint32_t)) != 0)	{ return false; }		// records are read in place
+	if((phdr->magic != kBtnCalMagic) || (phdr->version != kBtnCalVersion))		{ return false; }
+	if((phdr->numbuttons != pctx->numbuttons) || (phdr->recsize != sizeof(tBtnCalibration)))	{ return false; }
+	if(size < sizeof(tBtnCalImageHdr) + (pctx->numbuttons * sizeof(tBtnCalibration)))	{ return false; }
+
+	Btn_CtxSetCalibration(pctx, (tBtnCalibration const *)(phdr + 1));
+	return true;
+}
+
+#if (BTN_CAL_MMAP)
+bool
+Btn_CtxMapCalibration(ptBtnCtx pctx, char const *path)
+{
+	struct stat st;
+	void *pimage;
+	size_t size;
+	int fd;
+
+	if(!pctx || !path)	{ return false; }
+	fd = open(path, O_RDONLY);
+	if(fd < 0)	{ return false; }
+	if((fstat(fd, &st) != 0) || (st.st_size <= 0))
+	{
+		(void)close(fd);
+		return false;
+	}
+	size = (size_t)st.st_size;
+	pimage = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	(void)close(fd);				// the mapping outlives the descriptor
+	if(pimage == MAP_FAILED)	{ return false; }
+
+	if(!Btn_CtxSetCalibrationImage(pctx, pimage, size))
+	{
+		(void)munmap(pimage, size);
+		return false;
+	}
+
+	// the new image is in use; the old one can go.
+	if(pctx->pcalmapped)	{ (void)munmap(pctx->pcalmapped, pctx->calmappedsize); }
+	pctx->pcalmapped = pimage;
+	pctx->calmappedsize = size;
+	return true;
+}
+#endif
+
+#if (BTN_ADAPTIVE_DEBOUNCE)
+void
+Btn_CtxGetBounceProfile(ptBtnCtx pctx, uint16_t ptm[])
+{
+	uint32_t scantm, idx;
+
+	if(!pctx || !ptm)	{ return; }
+	scantm = (pctx->ptmr->reloadtm > 0) ? (uint32_t)pctx->ptmr->reloadtm : 1;
+	for(idx = 0; idx < pctx->numbuttons; ++idx)
+	{
+		ptm[idx] = (uint16_t)(pctx->btn.window[idx] * scantm * SampleEvery(pctx, idx));
+	}
+}
+
+void
+Btn_CtxSetBounceProfile(ptBtnCtx pctx, uint16_t const ptm[])
+{
+	uint32_t idx;
+
+	if(!pctx || !ptm)	{ return; }
+	for(idx = 0; idx < pctx->numbuttons; ++idx)
+	{
+		uint32_t window = 0;
+		if(ptm[idx])
+		{
+			window = SamplesFor(pctx, idx, ptm[idx], kBtnMaxDebounceSamples);
+			if(window < BTN_ADAPT_MIN_SAMPLES)	{ window = BTN_ADAPT_MIN_SAMPLES; }
+		}
+		pctx->btn.window[idx] = (uint8_t)window;
+		pctx->btn.calm[idx] = 0;
+	}
+}
+#endif
+
+#if (BTN_SCAN_GROUPS)
+bool
+Btn_CtxSetScanGroup(ptBtnCtx pctx, uint32_t group, uint16_t tmperiod)
+{
+	if(!pctx || (group >= BTN_SCAN_GROUPS))	{ return false; }
+	pctx->groups.tmperiod[group] = tmperiod;
+	return true;
+}
+#endif
+
+uint32_t
+Btn_CtxGetPostFailures(ptBtnCtx pctx)
+{
+	return pctx ? pctx->postfailures : 0;
+}
+
+#if (BTN_LATENCY_STATS)
+bool
+Btn_CtxGetLatency(ptBtnCtx pctx, uint32_t idx, tBtnLatencyStats *pstats)
+{
+	uint32_t const *phist;
+	uint32_t scantm, count, max, bucket;
+
+	if(!pctx || !pstats)	{ return false; }
+	scantm = (pctx->ptmr->reloadtm > 0) ? (uint32_t)pctx->ptmr->reloadtm : 1;
+	if(idx == kBtnLatencyAllButtons)
+	{
+		(void)memset(pctx->latency.merged, 0, sizeof(pctx->latency.merged));
+		count = max = 0;
+		for(idx = 0; idx < pctx->numbuttons; ++idx)
+		{
+			for(bucket = 0; bucket < kBtnLatBuckets; ++bucket)
+			{
+				pctx->latency.merged[bucket] += pctx->latency.hist[idx][bucket];
+			}
+			count += pctx->latency.count[idx];
+			if(pctx->latency.max[idx] > max)	{ max = pctx->latency.max[idx]; }
+		}
+		phist = pctx->latency.merged;
+	}
+	else if(idx < pctx->numbuttons)
+	{
+		phist = pctx->latency.hist[idx];
+		count = pctx->latency.count[idx];
+		max = pctx->latency.max[idx];
+	}
+	else
+	{
+		return false;
+	}
+
+	pstats->count	= count;
+	pstats->max		= max * scantm;
+	pstats->p50		= count ? LatPercentile(phist, count, max, 50) * scantm : 0;
+	pstats->p99		= count ? LatPercentile(phist, count, max, 99) * scantm : 0;
+	return true;
+}
+
+void
+Btn_CtxResetLatency(ptBtnCtx pctx)
+{
+	if(!pctx)	{ return; }
+	// a debounce in progress keeps its edge.
+	(void)memset(pctx->latency.count, 0, sizeof(pctx->latency.count));
+	(void)memset(pctx->latency.max, 0, sizeof(pctx->latency.max));
+	(void)memset(pctx->latency.hist, 0, sizeof(pctx->latency.hist));
+}
+#endif
+
+#if (BTN_PROFILE)
+bool
+Btn_CtxDumpProfile(ptBtnCtx pctx, pfBtnTextOut pfout)
+{
+	uint32_t idx, col;
+
+	if(!pctx || !pfout)	{ return false; }
+
+	pfout("btn");
+	for(col = 0; col < kBtnNumStates; ++col)		{ pfout(","); pfout(tblStateNames[col]); }
+	for(col = 0; col < kBtnNumTransitions; ++col)	{ pfout(","); pfout(tblTransitionNames[col]); }
+	pfout("\n");
+
+	for(idx = 0; idx < pctx->numbuttons; ++idx)
+	{
+		ProfileOutU32(pfout, "", idx);
+		for(col = 0; col < kBtnNumStates; ++col)
+		{
+			uint32_t dwell = pctx->profile.dwell[idx][col];
+			// the current state's stay so far.
+			if(col == pctx->btn.currentstate[idx])	{ dwell += pctx->scancount - pctx->profile.entered[idx]; }
+			ProfileOutU32(pfout, ",", dwell);
+		}
+		for(col = 0; col < kBtnNumTransitions; ++col)
+		{
+			ProfileOutU32(pfout, ",", pctx->profile.transitions[idx][col]);
+		}
+		pfout("\n");
+	}
+	return true;
+}
+
+void
+Btn_CtxResetProfile(ptBtnCtx pctx)
+{
+	uint32_t idx;
+	if(!pctx)	{ return; }
+	(void)memset(pctx->profile.transitions, 0, sizeof(pctx->profile.transitions));
+	(void)memset(pctx->profile.dwell, 0, sizeof(pctx->profile.dwell));
+	for(idx = 0; idx < pctx->numbuttons; ++idx)
+	{
+		pctx->profile.entered[idx] = pctx->scancount;
+	}
+}
+#endif
+
+#if (BTN_CHORDS)
+bool
+Btn_CtxSetChords(ptBtnCtx pctx, tBtnChord const *ptbl, uint32_t count, uint32_t tmwindow)
+{
+	uint32_t row, w;
+
+	if(!pctx || (count && !ptbl))		{ return false; }
+	if(count > (BTN_CHORD_SLOTS / 2))	{ return false; }
+
+	(void)memset(&pctx->chords, 0, sizeof(pctx->chords));
+	pctx->chords.ptbl = ptbl;
+	for(row = 0; row < count; ++row)
+	{
+		uint32_t nbuttons = 0;
+		uint32_t slot;
+
+		for(w = 0; w < kBtnNumPortWords; ++w)
+		{
+			tBtnPortWord word = ptbl[row].buttons[w];
+			for(; word; word &= word - 1)	{ ++nbuttons; }
+		}
+		if((nbuttons < 2) || ChordLookup(pctx, ptbl[row].buttons))
+		{
+			(void)memset(&pctx->chords, 0, sizeof(pctx->chords));
+			return false;
+		}
+
+		for(slot = ChordHash(ptbl[row].buttons); pctx->chords.index[slot]; slot = (slot + 1) & (BTN_CHORD_SLOTS - 1))	{}
+		pctx->chords.index[slot] = (uint16_t)(row + 1);
+		for(w = 0; w < kBtnNumPortWords; ++w)	{ pctx->chords.chordable[w] |= ptbl[row].buttons[w]; }
+	}
+	pctx->chords.window = ScansFor(pctx, tmwindow, UINT32_MAX);
+	return true;
+}
+#endif
+
+#if (BTN_GESTURES)
+void
+Btn_CtxSetGestures(ptBtnCtx pctx, tBtnGesture const *ptbl)
+{
+	if(!pctx)	{ return; }
+	(void)memset(&pctx->gestures, 0, sizeof(pctx->gestures));
+	pctx->gestures.ptbl = ptbl;
+}
+#endif
+
+void
+Btn_CtxSetInputSource(ptBtnCtx pctx, pfBtnInputSource pfsource)
+{
+	if(!pctx)	{ return; }
+	pctx->pfInputSource = pfsource;
+}
+
+void
+Btn_CtxSetInputTap(ptBtnCtx pctx, pfBtnInputTap pftap)
+{
+	if(!pctx)	{ return; }
+	pctx->pfInputTap = pftap;
+}
+
+bool
+Btn_CtxGetButtonStates(ptBtnCtx pctx, tBtnStates *pstates)
+{
+	uint32_t seq, now;
+
+	if(!pctx || !pstates)	{ return false; }
+	do {
+		seq = BTN_SEQ_LOAD(pctx->states.seq, acquire) & ~(uint32_t)1;
+		if(!seq)	{ return false; }
+		// the copy is a plain one, and races w/ a scan that laps this reader; the race is the sequence
+		//	lock's own. a torn copy is never returned: the scan that tore it also moved `seq` on.
+		*pstates = pctx->states.copy[(seq / 2) & 1];
+
+		// good unless a scan has since started to overwrite this copy, 2 publications on.
+		BTN_SEQ_FENCE(acquire);
+		now = BTN_SEQ_LOAD(pctx->states.seq, relaxed);
+	} while((uint32_t)(now - seq) > 2);
+	return true;
+}
+
+#if (BTN_BATCH_EVENTS)
+bool
+Btn_CtxGetBatch(ptBtnCtx pctx, uint32_t seq, tBtnBatch *pbatch)
+{
+	uint32_t age;
+
+	if(!pctx)	{ return false; }
+	age = pctx->batchlog.seq - seq;		// unsigned; wraps safely
+
+	// the batch being collected (age 0) is not yet published; its slot held the one before the oldest.
+	if(!pbatch || (age == 0) || (age > BTN_BATCH_DEPTH))	{ return false; }
+	*pbatch = pctx->batchlog.slot[(pctx->batchlog.cur + kBtnBatchSlots - age) % kBtnBatchSlots];
+	return true;
+}
+#endif
+
+
+void
+Btn_CtxSetQueue(ptBtnCtx pctx, tEvQ_EventID const evId, const ptEvQ_QueueCtrlEx pEvqx)
+{
+	if(!pctx)	{ return; }
+	// set queue for button activity
+	pctx->pBtnEvqx = pEvqx;
+	// set parameters for timer expiration notifications
+	pctx->ptmr->pEvQX = pEvqx;
+	pctx->ptmr->evid = evId;
+}
+
+
+// ----	Default instance --------------------------
+/* the original API: each call is its Btn_Ctx... counterpart, applied to the board's own buttons. */
+
+void
+Btn_tsk_ButtonRead(tEvQ_Event ev, uint32_t extra)	// uses DI lower layers
+{
+	Btn_CtxButtonRead(&btndefault, ev, extra);
+}
+
+void
+Btn_SetQueue(tEvQ_EventID const evId, const ptEvQ_QueueCtrlEx pEvqx)
+{
+	Btn_CtxSetQueue(&btndefault, evId, pEvqx);
+}
+
+void
+Btn_SetCalibration(tBtnCalibration const *pcal)
+{
+	Btn_CtxSetCalibration(&btndefault, pcal);
+}
+
+bool
+Btn_SetCalibrationImage(void const *pimage, size_t size)
+{
+	return Btn_CtxSetCalibrationImage(&btndefault, pimage, size);
+}
+
+#if (BTN_CAL_MMAP)
+bool
+Btn_MapCalibration(char const *path)
+{
+	return Btn_CtxMapCalibration(&btndefault, path);
+}
+#endif
+
+#if (BTN_ADAPTIVE_DEBOUNCE)
+void
+Btn_GetBounceProfile(uint16_t ptm[kBoardNumButtons])
+{
+	Btn_CtxGetBounceProfile(&btndefault, ptm);
+}
+
+void
+Btn_SetBounceProfile(uint16_t const ptm[kBoardNumButtons])
+{
+	Btn_CtxSetBounceProfile(&btndefault, ptm);
+}
+#endif
+
+#if (BTN_SCAN_GROUPS)
+bool
+Btn_SetScanGroup(uint32_t group, uint16_t tmperiod)
+{
+	return Btn_CtxSetScanGroup(&btndefault, group, tmperiod);
+}
+#endif
+
+uint32_t
+Btn_GetPostFailures(void)
+{
+	return Btn_CtxGetPostFailures(&btndefault);
+}
+
+#if (BTN_LATENCY_STATS)
+bool
+Btn_GetLatency(uint32_t idx, tBtnLatencyStats *pstats)
+{
+	return Btn_CtxGetLatency(&btndefault, idx, pstats);
+}
+
+void
+Btn_ResetLatency(void)
+{
+	Btn_CtxResetLatency(&btndefault);
+}
+#endif
+
+#if (BTN_PROFILE)
+bool
+Btn_DumpProfile(pfBtnTextOut pfout)
+{
+	return Btn_CtxDumpProfile(&btndefault, pfout);
+}
+
+void
+Btn_ResetProfile(void)
+{
+	Btn_CtxResetProfile(&btndefault);
+}
+#endif
+
+#if (BTN_CHORDS)
+bool
+Btn_SetChords(tBtnChord const *ptbl, uint32_t count, uint32_t tmwindow)
+{
+	return Btn_CtxSetChords(&btndefault, ptbl, count, tmwindow);
+}
+#endif
+
+#if (BTN_GESTURES)
+void
+Btn_SetGestures(tBtnGesture const *ptbl)
+{
+	Btn_CtxSetGestures(&btndefault, ptbl);
+}
+#endif
+
+void
+Btn_SetInputSource(pfBtnInputSource pfsource)
+{
+	Btn_CtxSetInputSource(&btndefault, pfsource);
+}
+
+void
+Btn_SetInputTap(pfBtnInputTap pftap)
+{
+	Btn_CtxSetInputTap(&btndefault, pftap);
+}
+
+bool
+Btn_GetButtonStates(tBtnStates *pstates)
+{
+	return Btn_CtxGetButtonStates(&btndefault, pstates);
+}
+
+tBtnStates
+Cwsw_Board__Get_ButtonStates(void)
+{
+	tBtnStates states;
+	if(!Btn_GetButtonStates(&states))	{ (void)memset(&states, 0, sizeof(states)); }
+	return states;
+}
+
+#if (BTN_BATCH_EVENTS)
+bool
+Btn_GetBatch(uint32_t seq, tBtnBatch *pbatch)
+{
+	return Btn_CtxGetBatch(&btndefault, seq, pbatch);
 }
+#endif
@@ -0,0 +1,237 @@
+/** @file
+ *	@brief	Record and replay of the button inputs seen by Btn_tsk_ButtonRead().
+ *
+ *	The recorder taps the inputs of every scan, after they have been read from whichever source is in
+ *	use (GTK or CVI callbacks, or a real port), so a field problem can be captured as the button
+ *	engine saw it. The player feeds a trace back through Btn_tsk_ButtonRead() in place of the DI, with
+ *	no UI and no pacing; since the engine's timers count scans, the replay posts the same events as
+ *	the original run.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdbool.h>
+#include <stdio.h>					// FILE
+#include <stdlib.h>					// malloc
+#include <string.h>					// memcmp, memcpy
+
+// ----	Project Headers -------------------------
+#include "cwsw_bsp_buttons.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_bsp_buttons_trace.h"
+
+#if (BTN_TRACE)
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/** Size of one run record. */
+enum { kBtnTraceRecSize = sizeof(uint32_t) + (sizeof(tBtnPortWord) * kBtnNumPortWords) };
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/// The trace is read and written as raw bytes; its header layout must not depend on the compiler.
+typedef char tBtnTraceHdrLayoutIsFixed[(sizeof(tBtnTraceHdr) == 12) ? 1 : -1];
+
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+/** Recording in progress. */
+static struct sBtnTraceRec {
+	FILE			*pfile;							//!< Trace being written; NULL when not recording.
+	tBtnPortWord	words[kBtnNumPortWords];		//!< Inputs of the current run.
+	uint32_t		run;							//!< Scans in the current run; 0 before the first scan.
+	bool			failed;							//!< A write has failed.
+} rec;
+
+/** Trace loaded for replay. */
+static struct sBtnTracePlay {
+	uint8_t			*pbuf;							//!< Whole trace file; NULL when none is loaded.
+	uint8_t const	*pnext;							//!< Next run record.
+	uint8_t const	*pend;							//!< End of the last whole record.
+	uint8_t const	*pwords;						//!< Inputs of the current run.
+	uint32_t		left;							//!< Scans left in the current run.
+} play;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/** Write out the current run, if any. */
+static void
+TraceFlushRun(void)
+{
+	if(rec.run)
+	{
+		if(	(fwrite(&rec.run, sizeof(rec.run), 1, rec.pfile) != 1) ||
+			(fwrite(rec.words, sizeof(rec.words), 1, rec.pfile) != 1))
+		{
+			rec.failed = true;
+		}
+		rec.run = 0;
+	}
+}
+
+/** Input tap: extend the current run, or start a new one. */
+static void
+TraceTap(tBtnPortWord const inputs[kBtnNumPortWords])
+{
+	if(rec.run && (rec.run < UINT32_MAX) && !memcmp(inputs, rec.words, sizeof(rec.words)))
+	{
+		++rec.run;
+		return;
+	}
+	TraceFlushRun();
+	(void)memcpy(rec.words, inputs, sizeof(rec.words));
+	rec.run = 1;
+}
+
+/** Input source: the inputs of the run being replayed. */
+static void
+TraceSource(tBtnPortWord inputs[kBtnNumPortWords])
+{
+	(void)memcpy(inputs, play.pwords, sizeof(tBtnPortWord) * kBtnNumPortWords);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+bool
+Btn_TraceRecord(char const *path)
+{
+	tBtnTraceHdr hdr;
+
+	if(rec.pfile || !path)	{ return false; }
+	rec.pfile = fopen(path, "wb");
+	if(!rec.pfile)			{ return false; }
+
+	hdr.magic		= kBtnTraceMagic;
+	hdr.version		= kBtnTraceVersion;
+	hdr.numbuttons	= kBoardNumButtons;
+	hdr.scantm		= (uint16_t)Btn_tmr_ButtonRead.reloadtm;
+	hdr.numwords	= kBtnNumPortWords;
+	rec.failed = (fwrite(&hdr, sizeof(hdr), 1, rec.pfile) != 1);
+	rec.run = 0;
+
+	Btn_SetInputTap(TraceTap);
+	return true;
+}
+
+bool
+Btn_TraceRecordStop(void)
+{
+	bool ok;
+	if(!rec.pfile)	{ return false; }
+
+	Btn_SetInputTap(NULL);
+	TraceFlushRun();
+	ok = !rec.failed;
+	if(fclose(rec.pfile) != 0)	{ ok = false; }
+	rec.pfile = NULL;
+	return ok;
+}
+
+bool
+Btn_TraceOpen(char const *path)
+{
+	tBtnTraceHdr hdr;
+	FILE *pfile;
+	long size;
+	bool ok = false;
+
+	if(!path)	{ return false; }
+	Btn_TraceClose();
+
+	pfile = fopen(path, "rb");
+	if(!pfile)	{ return false; }
+	do {
+		if(fseek(pfile, 0, SEEK_END) != 0)			{ break; }
+		size = ftell(pfile);
+		if(size < (long)sizeof(hdr))				{ break; }
+		if(fseek(pfile, 0, SEEK_SET) != 0)			{ break; }
+		play.pbuf = (uint8_t *)malloc((size_t)size);
+		if(!play.pbuf)								{ break; }
+		if(fread(play.pbuf, (size_t)size, 1, pfile) != 1)	{ break; }
+
+		(void)memcpy(&hdr, play.pbuf, sizeof(hdr));
+		if(hdr.magic != kBtnTraceMagic)				{ break; }
+		if(hdr.version != kBtnTraceVersion)			{ break; }
+		if(hdr.numbuttons != kBoardNumButtons)		{ break; }
+		if(hdr.numwords != kBtnNumPortWords)		{ break; }
+		if(hdr.scantm != (uint16_t)Btn_tmr_ButtonRead.reloadtm)	{ break; }
+
+		// a record cut short by a crash during recording is ignored.
+		play.pnext	= play.pbuf + sizeof(hdr);
+		play.pend	= play.pnext + ((((size_t)size - sizeof(hdr)) / kBtnTraceRecSize) * kBtnTraceRecSize);
+		play.left	= 0;
+		ok = true;
+	} while(0);
+	(void)fclose(pfile);
+
+	if(!ok)
+	{
+		Btn_TraceClose();
+		return false;
+	}
+	Btn_SetInputSource(TraceSource);
+	return true;
+}
+
+uint32_t
+Btn_TraceReplay(tEvQ_Event ev, uint32_t maxscans)
+{
+	uint32_t scans = 0;
+
+	if(!play.pbuf)	{ return 0; }
+	while(scans < maxscans)
+	{
+		if(!play.left)
+		{
+			if(play.pnext >= play.pend)	{ break; }
+			(void)memcpy(&play.left, play.pnext, sizeof(play.left));
+			play.pwords = play.pnext + sizeof(play.left);
+			play.pnext += kBtnTraceRecSize;
+			continue;
+		}
+		Btn_tsk_ButtonRead(ev, 0);
+		--play.left;
+		++scans;
+	}
+	return scans;
+}
+
+void
+Btn_TraceClose(void)
+{
+	if(play.pbuf)
+	{
+		Btn_SetInputSource(NULL);
+		free(play.pbuf);
+	}
+	memset(&play, 0, sizeof(play));
+}
+
+#endif	/* BTN_TRACE */
@@ -0,0 +1,153 @@
+/** @file
+ *	@brief	Edge timeline for the simulated digital inputs of the desktop boards.
+ *
+ *	Each simulated button keeps a short queue of timestamped level changes. UI callbacks append to
+ *	it as the user operates the button; the DI read samples the level in force at the instant of
+ *	the scan. Unlike the injected bit streams this replaces, nothing is quantized to the scan period,
+ *	and a burst of presses between two scans does not overflow the stream.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_board.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_bsp_di_sim.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/** Contact bounce applied to every simulated press and release, as offsets (ms) from the moment
+ *	the button was operated. The level alternates at each offset, starting with the new level:
+ *	contact for 10 ms, a 20 ms bounce back, then steady. This is the same shape as the 12-bit
+ *	"clean" pattern formerly shifted out one bit per 10 ms scan.
+ */
+static const tCwswClockTics bounceprofile[] = { 0, 10, 30 };
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/** One level change on a simulated input. */
+typedef struct sDiEdge {
+	tCwswClockTics	when;		//!< Clock time (ms) at which the level takes effect.
+	bool			level;		//!< Level from `when` onward.
+} tDiEdge;
+
+/** Per-button queue of pending edges, oldest first. */
+typedef struct sDiTimeline {
+	tDiEdge		edge[DI_SIM_EDGE_DEPTH];
+	uint16_t	head;			//!< Index of the oldest pending edge.
+	uint16_t	count;			//!< Number of pending edges.
+	bool		level;			//!< Level established by the last consumed edge.
+	bool		operated;		//!< The button has been operated; `lastop` is valid.
+	tCwswClockTics	lastop;		//!< Clock time (ms) at which the latest operation takes effect.
+} tDiTimeline;
+
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tDiTimeline timeline[kBoardNumButtons];
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/** Whether clock time `a` precedes `b`, across the wrap of the clock. The clock is signed; the
+ *	difference is taken unsigned, where wrapping is defined, and only then read as signed.
+ */
+static bool
+Before(tCwswClockTics a, tCwswClockTics b)
+{
+	return (int32_t)((uint32_t)a - (uint32_t)b) < 0;
+}
+
+/** Clock time `ms` after `t`, wrapping as the clock does. */
+static tCwswClockTics
+Later(tCwswClockTics t, tCwswClockTics ms)
+{
+	return (tCwswClockTics)((uint32_t)t + (uint32_t)ms);
+}
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+bool
+di_sim_add_transition(uint32_t idx, bool level, tCwswClockTics when)
+{
+	tDiTimeline *ptl;
+	unsigned edgeno;
+	uint16_t kept;
+
+	if(idx >= kBoardNumButtons)	{ return false; }
+	ptl = &timeline[idx];
+
+	// an operation no later than the previous one (a click's press and release share an instant)
+	//	follows it once it has settled and been held, rather than wiping it out.
+	if(ptl->operated && !Before(ptl->lastop, when))
+	{
+		when = Later(ptl->lastop, bounceprofile[TABLE_SIZE(bounceprofile) - 1] + DI_SIM_CLICK_HOLD);
+	}
+
+	// operating the button again cuts short whatever is left of the previous bounce; this also keeps
+	//	the queue in time order, even if the caller's time base jitters a little. the edges are only
+	//	dropped once the new ones are sure to fit.
+	kept = ptl->count;
+	while(kept && !Before(ptl->edge[(ptl->head + kept - 1) % DI_SIM_EDGE_DEPTH].when, when))
+	{
+		--kept;
+	}
+	if(kept + TABLE_SIZE(bounceprofile) > DI_SIM_EDGE_DEPTH)	{ return false; }
+	ptl->count = kept;
+
+	for(edgeno = 0; edgeno < TABLE_SIZE(bounceprofile); ++edgeno)
+	{
+		tDiEdge *pedge = &ptl->edge[(ptl->head + ptl->count) % DI_SIM_EDGE_DEPTH];
+		pedge->when		= Later(when, bounceprofile[edgeno]);
+		pedge->level	= (edgeno & 1) ? !level : level;
+		++ptl->count;
+	}
+	ptl->operated	= true;
+	ptl->lastop		= when;
+	return true;
+}
+
+bool
+di_sim_level_at(uint32_t idx, tCwswClockTics now)
+{
+	tDiTimeline *ptl;
+
+	if(idx >= kBoardNumButtons)	{ return false; }
+	ptl = &timeline[idx];
+
+	while(ptl->count && !Before(now, ptl->edge[ptl->head].when))
+	{
+		ptl->level = ptl->edge[ptl->head].level;
+		ptl->head = (uint16_t)((ptl->head + 1) % DI_SIM_EDGE_DEPTH);
+		--ptl->count;
+	}
+	return ptl->level;
+}
@@ -0,0 +1,198 @@
+/** @file
+ *	@brief	Resistor-ladder keypads: several buttons on one analog input, decoded into button inputs.
+ *
+ *	Each button of a ladder pulls the input to its own level, so one channel carries 4 to 8 buttons
+ *	(or more). The decoder classifies every raw sample of a block as the acquisition task reads it,
+ *	and keeps the button of the latest; the button SME samples that through the board's DI, and
+ *	debounces it as it does any discrete input. The events are the same; the port pins are fewer.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdbool.h>
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>				// decoded buttons
+#define LADDER_ATOMIC	1
+#else
+#define LADDER_ATOMIC	0
+#endif
+
+// ----	Project Headers -------------------------
+#include "cwsw_board.h"				// this module builds on top of the BSP
+
+// ----	Module Headers --------------------------
+#include "cwsw_bsp_ladder.h"		// public API for this module
+
+#if (BOARD_LADDER)
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/** Decoded button of each ladder; one word, read by the scan while the acquisition task writes it. */
+#if (LADDER_ATOMIC)
+typedef atomic_uint_least16_t	tLadderButton;
+#define LADDER_LOAD(v)			atomic_load_explicit(&(v), memory_order_relaxed)
+#define LADDER_STORE(v, x)		atomic_store_explicit(&(v), (x), memory_order_relaxed)
+#else
+typedef volatile uint16_t		tLadderButton;
+#define LADDER_LOAD(v)			(v)
+#define LADDER_STORE(v, x)		((v) = (x))
+#endif
+
+enum eLadderSizes {
+	kLadderNoBand	= UINT8_MAX		//!< Band of a ladder w/ no sample classified yet.
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/// A band index fits a byte, w/ a value to spare for #kLadderNoBand.
+typedef char tLadderBandsFitAByte[((LADDER_MAX_BANDS >= 2) && (LADDER_MAX_BANDS < kLadderNoBand)) ? 1 : -1];
+
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tLadder const	*pladders = NULL;
+static uint32_t			numladders = 0;
+
+/** Decoder state of each ladder. `band` belongs to the acquisition task; `button` is what it
+ *	publishes.
+ */
+static struct sLadderState {
+	uint8_t			band[LADDER_MAX_LADDERS];		//!< Band of the latest sample.
+	tLadderButton	button[LADDER_MAX_LADDERS];		//!< Button of that band.
+} ldr;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/** Band a reading falls in, w/o regard to hysteresis: the last whose `lower` is at or below it. */
+static uint32_t
+Classify(tLadder const *pl, uint32_t x)
+{
+	uint32_t lo = 0, hi = pl->numbands;
+	while((hi - lo) > 1)
+	{
+		uint32_t mid = (lo + hi) / 2;
+		if(x >= pl->pbands[mid].lower)	{ lo = mid; }
+		else							{ hi = mid; }
+	}
+	return lo;
+}
+
+/** Classify one ladder's samples in a block. Most samples stay in the current band, and cost one
+ *	pair of compares; only a change of band searches the table.
+ */
+static void
+DecodeLadder(uint32_t l, uint16_t const *pframes, uint32_t nframes)
+{
+	tLadder const *pl = &pladders[l];
+	uint16_t const *pin = &pframes[pl->ch];
+	uint32_t band = ldr.band[l];
+	uint32_t lo = 1, hi = 0;		// the current band's edges, widened by the hysteresis; empty if none.
+	uint32_t f;
+
+	if(band != kLadderNoBand)
+	{
+		lo = (band > 0) ? pl->pbands[band].lower - pl->hysteresis : 0;
+		hi = (band < (uint32_t)(pl->numbands - 1)) ? pl->pbands[band + 1].lower + pl->hysteresis : UINT32_MAX;
+	}
+	for(f = 0; f < nframes; ++f, pin += kBoardNumAnalogs)
+	{
+		uint32_t x = *pin;
+		if((x >= lo) && (x < hi))	{ continue; }
+
+		band = Classify(pl, x);
+		lo = (band > 0) ? pl->pbands[band].lower - pl->hysteresis : 0;
+		hi = (band < (uint32_t)(pl->numbands - 1)) ? pl->pbands[band + 1].lower + pl->hysteresis : UINT32_MAX;
+	}
+	if(band != ldr.band[l])
+	{
+		ldr.band[l] = (uint8_t)band;
+		LADDER_STORE(ldr.button[l], pl->pbands[band].button);
+	}
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+bool
+Ladder_SetTable(tLadder const *ptbl, uint32_t count)
+{
+	uint32_t l, b;
+
+	numladders = 0;
+	pladders = NULL;
+	for(l = 0; l < LADDER_MAX_LADDERS; ++l)
+	{
+		ldr.band[l] = kLadderNoBand;
+		LADDER_STORE(ldr.button[l], kLadderNoButton);
+	}
+
+	if(count > LADDER_MAX_LADDERS)	{ return false; }
+	if(count && !ptbl)				{ return false; }
+	for(l = 0; l < count; ++l)
+	{
+		tLadder const *pl = &ptbl[l];
+		if(pl->ch >= kBoardNumAnalogs)											{ return false; }
+		if(!pl->pbands || (pl->numbands < 2) || (pl->numbands > LADDER_MAX_BANDS))	{ return false; }
+		if(pl->pbands[0].lower != 0)											{ return false; }
+
+		// hysteresis on both edges of a band must leave some of it.
+		for(b = 1; b < pl->numbands; ++b)
+		{
+			if(pl->pbands[b].lower <= pl->pbands[b - 1].lower + (2UL * pl->hysteresis))	{ return false; }
+		}
+	}
+
+	pladders = ptbl;
+	numladders = count;
+	return true;
+}
+
+void
+Ladder_Decode(uint16_t const *pframes, uint32_t nframes)
+{
+	uint32_t l;
+	if(!pframes || !nframes)	{ return; }
+	for(l = 0; l < numladders; ++l)
+	{
+		DecodeLadder(l, pframes, nframes);
+	}
+}
+
+bool
+Ladder_ButtonInput(uint32_t idx)
+{
+	uint32_t l;
+	if(idx == kLadderNoButton)	{ return false; }
+	for(l = 0; l < LADDER_MAX_LADDERS; ++l)
+	{
+		if(LADDER_LOAD(ldr.button[l]) == idx)	{ return true; }
+	}
+	return false;
+}
+
+#endif	/* BOARD_LADDER */
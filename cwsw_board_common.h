@@ -93,6 +93,23 @@ extern uint16_t Cwsw_Board__Init(ptEvQ_QueueCtrlEx pEvQX);
 /** Target for Get(Cwsw_Board, Initialized) interface */
 extern bool 	Cwsw_Board__Get_Initialized(void);
 
+/** Read the next sample of one button input.
+ *	Supplied by each board's DI layer; on simulated boards, this samples the input's edge timeline
+ *	at the instant of the call.
+ *	@param[in]	idx	Button ID, one of the board's `eBoardButtons` values.
+ *	@returns true if the input is active (button pressed).
+ */
+extern bool 	di_read_next_button_input_bit(uint32_t idx);
+
+/** Read the analog input frames sampled since the last call, oldest first.
+ *	Supplied by each board w/ analog inputs (see `BOARD_ANALOG` in cwsw_bsp_analog.h). A frame is one
+ *	sample of every channel, in `eBoardAnalogs` order, taken at the board's `kBoardAnalogRateHz`.
+ *	@param[out]	pframes		Destination for up to `maxframes` frames, back to back.
+ *	@param[in]	maxframes	Most frames to read.
+ *	@returns the number of frames read; less than `maxframes` once every sampled frame has been read.
+ */
+extern uint32_t	ai_read_samples(uint16_t *pframes, uint32_t maxframes);
+
 
 // ==== /Discrete Functions ================================================= }
 
@@ -88,6 +88,29 @@ enum eBoardButtons
 	kBoardNumButtons
 };
 
+/** Buttons wired to an input; kBoardButtonNone is a placeholder. */
+#define BTN_WIRED_MASK		(~((uint64_t)1 << kBoardButtonNone))
+
+/** Analog input channels for this board. Fed by a signal generator (see ai_synth.c). */
+enum eBoardAnalogs
+{
+	kBoardAnalog0,
+	kBoardAnalog1,
+	kBoardAnalog2,
+	kBoardAnalog3,
+	kBoardAnalog4,
+	kBoardAnalog5,
+	kBoardAnalog6,
+	kBoardAnalog7,
+	kBoardNumAnalogs
+};
+
+/** Frames per second sampled on the analog inputs. */
+enum { kBoardAnalogRateHz = 1000 };
+
+/** This board has analog inputs; see cwsw_bsp_analog.h. */
+#define BOARD_ANALOG		1
+
 /** tBoardLed.
  * Summary:
  *	Defines the LEDs available on this board.
@@ -0,0 +1,123 @@
+/** @file
+ *	@brief	Signal generator behind the analog inputs of the "none" board.
+ *
+ *	Stands in for a DMA-driven ADC scan: each channel carries a synthetic signal plus noise, and
+ *	frames accrue at kBoardAnalogRateHz of the clock service's time, to be read in blocks by the
+ *	acquisition task.
+ *
+ *	\copyright
+ *	Copyright (c) 2026 agent. All rights reserved.
+ *
+ *	Created on: Oct 16, 2026
+ *	@author agent
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_lib.h"					/* tCwswClockTics */
+
+// ----	Module Headers --------------------------
+#include "cwsw_board.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum eAiSynth {
+	kSynthFullScale	= 4095,							//!< 12-bit converter.
+	kSynthNoise		= 32,							//!< Peak noise, in counts.
+	kSynthBacklog	= kBoardAnalogRateHz / 10		//!< Most frames held for a late reader (100 ms); older ones are lost, as from a DMA ring.
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static bool				started = false;
+static tCwswClockTics	tmstart;		//!< Clock time of frame 0.
+static uint32_t			framenext;		//!< Next frame to hand over.
+static uint32_t			noiseseed = 1;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/** One sample of one channel. By channel, a triangle wave, a square wave (for step response) or a
+ *	steady mid-scale level, each w/ noise; the waves' periods double every 3 channels, from 256 frames.
+ */
+static uint16_t
+SynthSample(uint32_t ch, uint32_t frame)
+{
+	uint32_t period = 256UL << ((ch / 3) % 4);
+	uint32_t t = frame % period;
+	int32_t v;
+
+	switch(ch % 3)
+	{
+	case 0:		v = (int32_t)(((t < period / 2) ? t : period - t) * 2 * kSynthFullScale / period);		break;
+	case 1:		v = (t < period / 2) ? kSynthFullScale / 4 : (3 * kSynthFullScale) / 4;				break;
+	default:	v = kSynthFullScale / 2;																break;
+	}
+
+	noiseseed = (noiseseed * 1103515245UL) + 12345UL;
+	v += (int32_t)((noiseseed >> 16) % ((2 * kSynthNoise) + 1)) - kSynthNoise;
+	if(v < 0)				{ v = 0; }
+	if(v > kSynthFullScale)	{ v = kSynthFullScale; }
+	return (uint16_t)v;
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+uint32_t
+ai_read_samples(uint16_t *pframes, uint32_t maxframes)
+{
+	tCwswClockTics now = Cwsw_ClockSvc__GetTime();
+	uint32_t due, n;
+
+	if(!pframes)	{ return 0; }
+	if(!started)
+	{
+		tmstart = now;
+		started = true;
+	}
+
+	// frames sampled by now, less those handed over.
+	due = (uint32_t)(((uint64_t)(uint32_t)(now - tmstart) * kBoardAnalogRateHz) / 1000U) - framenext;
+	if(due > kSynthBacklog)
+	{
+		framenext += due - kSynthBacklog;
+		due = kSynthBacklog;
+	}
+	if(due > maxframes)	{ due = maxframes; }
+
+	for(n = 0; n < due; ++n, ++framenext)
+	{
+		uint32_t ch;
+		for(ch = 0; ch < kBoardNumAnalogs; ++ch)
+		{
+			*pframes++ = SynthSample(ch, framenext);
+		}
+	}
+	return due;
+}